@@ -0,0 +1,230 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "ActorIndex.h"
+
+#include "Scriptable/Actor.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace GemRB {
+
+//script names are compared case insensitively on 32 characters
+static std::string NameKey(const char *name)
+{
+	std::string key;
+	for (int i = 0; i < 32 && name[i]; i++) {
+		key += (char) tolower(name[i]);
+	}
+	return key;
+}
+
+static bool NewerSlot(const std::pair<unsigned int, Actor*> &a, const std::pair<unsigned int, Actor*> &b)
+{
+	return a.first > b.first;
+}
+
+ActorIndex::ActorIndex()
+{
+	Cols = Rows = 1;
+	Cells.resize(1);
+	Sequence = 0;
+	MaxSize = 0;
+}
+
+ActorIndex::~ActorIndex()
+{
+}
+
+void ActorIndex::Resize(unsigned int width, unsigned int height)
+{
+	Cols = (width + ACTOR_CELL_SIZE - 1) / ACTOR_CELL_SIZE;
+	Rows = (height + ACTOR_CELL_SIZE - 1) / ACTOR_CELL_SIZE;
+	if (!Cols) Cols = 1;
+	if (!Rows) Rows = 1;
+	Cells.clear();
+	Cells.resize(Cols * Rows);
+	for (EntryMap::iterator it = Entries.begin(); it != Entries.end(); ++it) {
+		FileCell(it->first, it->second);
+	}
+}
+
+//positions outside the area are filed in the border cells
+unsigned int ActorIndex::GetCell(int x, int y) const
+{
+	int col = x < 0 ? 0 : x / ACTOR_CELL_SIZE;
+	int row = y < 0 ? 0 : y / ACTOR_CELL_SIZE;
+	if (col >= (int) Cols) col = Cols - 1;
+	if (row >= (int) Rows) row = Rows - 1;
+	return row * Cols + col;
+}
+
+void ActorIndex::FileCell(Actor *actor, Entry &entry)
+{
+	Slot slot = { actor, entry.seq };
+	entry.cell = GetCell(actor->Pos.x, actor->Pos.y);
+	Cells[entry.cell].push_back(slot);
+	if (actor->size > MaxSize) {
+		MaxSize = actor->size;
+	}
+}
+
+void ActorIndex::UnfileCell(Actor *actor, const Entry &entry)
+{
+	std::vector<Slot> &cell = Cells[entry.cell];
+	for (size_t i = 0; i < cell.size(); i++) {
+		if (cell[i].actor == actor) {
+			cell[i] = cell.back();
+			cell.pop_back();
+			return;
+		}
+	}
+}
+
+void ActorIndex::FileName(Actor *actor, Entry &entry)
+{
+	Slot slot = { actor, entry.seq };
+	entry.name = NameKey(actor->GetScriptName());
+	Names.insert(NameMap::value_type(entry.name, slot));
+}
+
+void ActorIndex::UnfileName(Actor *actor, const Entry &entry)
+{
+	std::pair<NameMap::iterator, NameMap::iterator> range = Names.equal_range(entry.name);
+	for (NameMap::iterator it = range.first; it != range.second; ++it) {
+		if (it->second.actor == actor) {
+			Names.erase(it);
+			return;
+		}
+	}
+}
+
+void ActorIndex::Add(Actor *actor)
+{
+	if (Entries.find(actor) != Entries.end()) {
+		return;
+	}
+	Entry &entry = Entries[actor];
+	entry.seq = Sequence++;
+	FileCell(actor, entry);
+	FileName(actor, entry);
+	GlobalIDs[actor->GetGlobalID()] = actor;
+}
+
+void ActorIndex::Remove(Actor *actor)
+{
+	EntryMap::iterator it = Entries.find(actor);
+	if (it == Entries.end()) {
+		return;
+	}
+	UnfileCell(actor, it->second);
+	UnfileName(actor, it->second);
+	GlobalIDs.erase(actor->GetGlobalID());
+	Entries.erase(it);
+}
+
+bool ActorIndex::Contains(Actor *actor) const
+{
+	return Entries.find(actor) != Entries.end();
+}
+
+void ActorIndex::Move(Actor *actor)
+{
+	EntryMap::iterator it = Entries.find(actor);
+	if (it == Entries.end()) {
+		return;
+	}
+	Entry &entry = it->second;
+	//this runs on every step, so only touch the grid when the cell changed
+	if (GetCell(actor->Pos.x, actor->Pos.y) != entry.cell) {
+		UnfileCell(actor, entry);
+		FileCell(actor, entry);
+	} else if (actor->size > MaxSize) {
+		MaxSize = actor->size;
+	}
+}
+
+void ActorIndex::Rename(Actor *actor)
+{
+	EntryMap::iterator it = Entries.find(actor);
+	if (it == Entries.end()) {
+		return;
+	}
+	Entry &entry = it->second;
+	UnfileName(actor, entry);
+	FileName(actor, entry);
+}
+
+void ActorIndex::Update(Actor *actor)
+{
+	Move(actor);
+	Rename(actor);
+}
+
+Actor *ActorIndex::FindByGlobalID(ieDword globalID) const
+{
+	std::map<ieDword, Actor*>::const_iterator it = GlobalIDs.find(globalID);
+	if (it == GlobalIDs.end()) {
+		return NULL;
+	}
+	return it->second;
+}
+
+Actor *ActorIndex::FindByName(const char *name) const
+{
+	std::pair<NameMap::const_iterator, NameMap::const_iterator> range = Names.equal_range(NameKey(name));
+	const Slot *newest = NULL;
+	for (NameMap::const_iterator it = range.first; it != range.second; ++it) {
+		if (!newest || it->second.seq > newest->seq) {
+			newest = &it->second;
+		}
+	}
+	return newest ? newest->actor : NULL;
+}
+
+void ActorIndex::Query(const Region &rgn, std::vector<Actor*> &result) const
+{
+	std::vector<std::pair<unsigned int, Actor*> > found;
+	unsigned int first = GetCell(rgn.x, rgn.y);
+	unsigned int last = GetCell(rgn.x + rgn.w - 1, rgn.y + rgn.h - 1);
+	unsigned int col1 = first % Cols, row1 = first / Cols;
+	unsigned int col2 = last % Cols, row2 = last / Cols;
+
+	for (unsigned int row = row1; row <= row2; row++) {
+		for (unsigned int col = col1; col <= col2; col++) {
+			const std::vector<Slot> &cell = Cells[row * Cols + col];
+			for (size_t i = 0; i < cell.size(); i++) {
+				if (rgn.PointInside(cell[i].actor->Pos)) {
+					found.push_back(std::make_pair(cell[i].seq, cell[i].actor));
+				}
+			}
+		}
+	}
+
+	std::sort(found.begin(), found.end(), NewerSlot);
+	result.clear();
+	result.reserve(found.size());
+	for (size_t i = 0; i < found.size(); i++) {
+		result.push_back(found[i].second);
+	}
+}
+
+}
@@ -0,0 +1,104 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef ACTORINDEX_H
+#define ACTORINDEX_H
+
+#include "exports.h"
+#include "ie_types.h"
+
+#include "Region.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace GemRB {
+
+class Actor;
+
+//size of a grid cell side, in pixels
+#define ACTOR_CELL_SIZE 256
+
+/**
+ * @class ActorIndex
+ * Lookup tables over the actors of an area: a uniform grid of their
+ * positions and hashes of their global ids and script names.
+ * The owner has to call Move when an actor moves or changes its circle
+ * size and Rename when its script name changes. Results keep the order of a backward walk of
+ * Map::actors (most recently added first), which the linear scans
+ * this replaces relied on.
+ */
+
+class GEM_EXPORT ActorIndex {
+public:
+	ActorIndex();
+	~ActorIndex();
+
+	/** sets the area size in pixels, refiling the indexed actors */
+	void Resize(unsigned int width, unsigned int height);
+	void Add(Actor *actor);
+	void Remove(Actor *actor);
+	bool Contains(Actor *actor) const;
+	/** refiles an actor after its position or circle size changed */
+	void Move(Actor *actor);
+	/** refiles an actor after its script name changed */
+	void Rename(Actor *actor);
+	/** refiles an actor completely, for changes made while it was not watched */
+	void Update(Actor *actor);
+	Actor *FindByGlobalID(ieDword globalID) const;
+	/** returns the most recently added actor with this script name */
+	Actor *FindByName(const char *name) const;
+	/** collects the actors standing in the region */
+	void Query(const Region &rgn, std::vector<Actor*> &result) const;
+	/** the largest circle size among the indexed actors */
+	int GetMaxSize() const { return MaxSize; }
+
+private:
+	struct Slot {
+		Actor *actor;
+		unsigned int seq;
+	};
+	struct Entry {
+		unsigned int cell;
+		unsigned int seq;
+		std::string name;
+	};
+	typedef std::map<Actor*, Entry> EntryMap;
+	typedef std::multimap<std::string, Slot> NameMap;
+
+	unsigned int Cols, Rows;
+	std::vector<std::vector<Slot> > Cells;
+	EntryMap Entries;
+	std::map<ieDword, Actor*> GlobalIDs;
+	NameMap Names;
+	unsigned int Sequence;
+	int MaxSize;
+
+	unsigned int GetCell(int x, int y) const;
+	void FileCell(Actor *actor, Entry &entry);
+	void UnfileCell(Actor *actor, const Entry &entry);
+	void FileName(Actor *actor, Entry &entry);
+	void UnfileName(Actor *actor, const Entry &entry);
+};
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "AreaPrefetch.h"
+
+#include "win32def.h"
+
+#include "GameData.h"
+#include "Interface.h"
+#include "PluginMgr.h"
+#include "System/DataStream.h"
+#include "System/MemoryStream.h"
+
+namespace GemRB {
+
+//how long the read ahead may take in a single game tick (ms)
+#define PREFETCH_BUDGET 2
+//how long a request has to stay the same before the area file is parsed (ms),
+//so sweeping the worldmap cursor over the areas doesn't open each of them
+#define PREFETCH_DELAY 250
+//the size of a single read, the budget is checked between them
+#define PREFETCH_CHUNK 65536
+//how much memory the resources read ahead may use in total
+#define PREFETCH_LIMIT (64*1024*1024)
+
+AreaPrefetch::AreaPrefetch()
+{
+	Pending[0] = 0;
+	PendingTime = 0;
+	Area[0] = 0;
+	QueuePos = 0;
+	Stream = NULL;
+	Buffer = NULL;
+	BufferSize = BufferPos = 0;
+	Total = 0;
+	Time = 0;
+}
+
+AreaPrefetch::~AreaPrefetch()
+{
+	delete Stream;
+	free(Buffer);
+}
+
+void AreaPrefetch::Reset()
+{
+	delete Stream;
+	Stream = NULL;
+	free(Buffer);
+	Buffer = NULL;
+	BufferSize = BufferPos = 0;
+	Area[0] = 0;
+	Queue.clear();
+	QueuePos = 0;
+	Total = 0;
+	Time = 0;
+	gamedata->ClearPrefetched();
+}
+
+void AreaPrefetch::Request(const char *ResRef)
+{
+	if (!ResRef[0] || !strnicmp(Area, ResRef, 8)) {
+		Pending[0] = 0;
+		return;
+	}
+	if (strnicmp(Pending, ResRef, 8)) {
+		CopyResRef(Pending, ResRef);
+		PendingTime = GetTickCount();
+	}
+}
+
+void AreaPrefetch::Open(const char *ResRef)
+{
+	Reset();
+
+	PluginHolder<MapMgr> mM(IE_ARE_CLASS_ID);
+	if (!mM) {
+		return;
+	}
+	DataStream* ds = gamedata->GetResource( ResRef, IE_ARE_CLASS_ID, true );
+	if (!ds || !mM->Open(ds)) {
+		return;
+	}
+	mM->GetResources(Queue);
+	CopyResRef(Area, ResRef);
+}
+
+void AreaPrefetch::NextResource()
+{
+	const AreaResource &res = Queue[QueuePos];
+	Stream = gamedata->GetResource( res.ResRef, res.Type, true );
+	if (!Stream) {
+		QueuePos++;
+		return;
+	}
+	BufferSize = Stream->Remains();
+	if (!BufferSize || Total + BufferSize > PREFETCH_LIMIT) {
+		delete Stream;
+		Stream = NULL;
+		QueuePos++;
+		return;
+	}
+	Buffer = (char *) malloc(BufferSize);
+	BufferPos = 0;
+}
+
+void AreaPrefetch::Update()
+{
+	unsigned long start = GetTickCount();
+	if (Pending[0] && start - PendingTime >= PREFETCH_DELAY) {
+		//parsing the area file is all the work for this tick
+		Open(Pending);
+		Pending[0] = 0;
+		Time += GetTickCount() - start;
+		return;
+	}
+
+	unsigned long now = start;
+	while (now - start < PREFETCH_BUDGET) {
+		if (!Stream) {
+			if (QueuePos >= Queue.size()) {
+				break;
+			}
+			NextResource();
+			now = GetTickCount();
+			continue;
+		}
+
+		unsigned long chunk = BufferSize - BufferPos;
+		if (chunk > PREFETCH_CHUNK) {
+			chunk = PREFETCH_CHUNK;
+		}
+		if (Stream->Read(Buffer + BufferPos, chunk) != (int) chunk) {
+			free(Buffer);
+			Buffer = NULL;
+			delete Stream;
+			Stream = NULL;
+			QueuePos++;
+		} else {
+			BufferPos += chunk;
+			if (BufferPos == BufferSize) {
+				const AreaResource &res = Queue[QueuePos++];
+				//the memory stream owns the buffer from now on
+				gamedata->AddPrefetched(res.ResRef, res.Type, new MemoryStream(Stream->originalfile, Buffer, BufferSize));
+				Total += BufferSize;
+				Buffer = NULL;
+				delete Stream;
+				Stream = NULL;
+			}
+		}
+		now = GetTickCount();
+	}
+	Time += now - start;
+}
+
+void AreaPrefetch::Loaded(const char *ResRef, unsigned long loadTime)
+{
+	if (!strnicmp(Pending, ResRef, 8)) {
+		Pending[0] = 0;
+	}
+	if (strnicmp(Area, ResRef, 8)) {
+		Log(DEBUG, "Game", "Loaded %.8s in %lu ms", ResRef, loadTime);
+		return;
+	}
+	Log(DEBUG, "Game", "Loaded %.8s in %lu ms, %lu ms were read ahead (%d/%d resources, %lu bytes)",
+		ResRef, loadTime, Time, (int) QueuePos, (int) Queue.size(), Total);
+	Reset();
+}
+
+}
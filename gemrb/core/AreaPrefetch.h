@@ -0,0 +1,78 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef AREAPREFETCH_H
+#define AREAPREFETCH_H
+
+#include "exports.h"
+#include "ie_types.h"
+
+#include "MapMgr.h"
+
+#include <vector>
+
+namespace GemRB {
+
+class DataStream;
+
+/**
+ * @class AreaPrefetch
+ * Reads the resources of an area the party is likely to enter next into
+ * memory, in small slices over the game ticks. Finished resources are
+ * handed to gamedata, so the loaders of LoadMap get them without touching
+ * the disk again.
+ */
+
+class GEM_EXPORT AreaPrefetch {
+public:
+	AreaPrefetch();
+	~AreaPrefetch();
+
+	/** asks for an area to be read ahead, the area file is only opened
+	 * once the same area was asked for long enough */
+	void Request(const char *ResRef);
+	/** reads ahead for at most a few milliseconds */
+	void Update();
+	/** logs the read ahead of a freshly loaded area and drops what it didn't use */
+	void Loaded(const char *ResRef, unsigned long loadTime);
+
+private:
+	ieResRef Pending;
+	unsigned long PendingTime;
+	ieResRef Area;
+	std::vector<AreaResource> Queue;
+	size_t QueuePos;
+	/** the resource being read and how much of it is in Buffer */
+	DataStream *Stream;
+	char *Buffer;
+	unsigned long BufferSize, BufferPos;
+	/** bytes handed over to gamedata */
+	unsigned long Total;
+	/** ms spent reading ahead for Area */
+	unsigned long Time;
+
+	void Open(const char *ResRef);
+	void Reset();
+	void NextResource();
+};
+
+}
+
+#endif
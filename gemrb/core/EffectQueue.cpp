@@ -341,6 +341,7 @@ void EffectQueue_RegisterOpcodes(int count, const EffectDesc* opcodes)
 EffectQueue::EffectQueue()
 {
 	Owner = NULL;
+	memset(OpcodeMask, 0, sizeof(OpcodeMask));
 }
 
 EffectQueue::~EffectQueue()
@@ -476,6 +477,7 @@ void EffectQueue::AddEffect(Effect* fx, bool insert)
 {
 	Effect* new_fx = new Effect;
 	memcpy( new_fx, fx, sizeof( Effect ) );
+	MarkOpcode(new_fx->Opcode);
 	if( insert) {
 		effects.insert( effects.begin(), new_fx );
 	} else {
@@ -521,11 +523,13 @@ void EffectQueue::Cleanup()
 {
 	std::list< Effect* >::iterator f;
 
+	memset(OpcodeMask, 0, sizeof(OpcodeMask));
 	for ( f = effects.begin(); f != effects.end(); ) {
 		if( (*f)->TimingMode == FX_DURATION_JUST_EXPIRED) {
 			delete *f;
 			effects.erase(f++);
 		} else {
+			MarkOpcode((*f)->Opcode);
 			f++;
 		}
 	}
@@ -1303,6 +1307,8 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 
 		res=fn( Owner, target, fx );
 		fx->FirstApply = 0;
+		//some effects turn into another opcode
+		MarkOpcode(fx->Opcode);
 
 		//if there is no owner, we assume it is the target
 		switch( res ) {
@@ -1367,6 +1373,9 @@ static inline bool IsLive(ieByte timingmode)
 //will be killed along with it
 void EffectQueue::RemoveAllEffects(ieDword opcode) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1436,6 +1445,9 @@ void EffectQueue::RemoveAllEffects(EffectRef &effect_reference) const
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithResource(ieDword opcode, const ieResRef resource) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1457,6 +1469,9 @@ void EffectQueue::RemoveAllEffectsWithResource(EffectRef &effect_reference, cons
 //(works only if a higher stat means good for the target)
 void EffectQueue::RemoveAllDetrimentalEffects(ieDword opcode, ieDword current) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1491,6 +1506,9 @@ void EffectQueue::RemoveAllDetrimentalEffects(EffectRef &effect_reference, ieDwo
 //opcode need to be removed (see removal of portrait icon)
 void EffectQueue::RemoveAllEffectsWithParam(ieDword opcode, ieDword param2) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1511,6 +1529,9 @@ void EffectQueue::RemoveAllEffectsWithParam(EffectRef &effect_reference, ieDword
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithParamAndResource(ieDword opcode, ieDword param2, const ieResRef resource) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1607,6 +1628,9 @@ void EffectQueue::RemoveLevelEffects(ieResRef &Removed, ieDword level, ieDword F
 
 Effect *EffectQueue::HasOpcode(ieDword opcode) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return NULL;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1628,6 +1652,9 @@ Effect *EffectQueue::HasEffect(EffectRef &effect_reference) const
 
 Effect *EffectQueue::HasOpcodeWithParam(ieDword opcode, ieDword param2) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return NULL;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1654,6 +1681,9 @@ Effect *EffectQueue::HasEffectWithParam(EffectRef &effect_reference, ieDword par
 
 Effect *EffectQueue::HasOpcodeWithParamPair(ieDword opcode, ieDword param1, ieDword param2) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return NULL;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1682,6 +1712,9 @@ Effect *EffectQueue::HasEffectWithParamPair(EffectRef &effect_reference, ieDword
 //this could be used for stoneskins and mirror images as well
 void EffectQueue::DecreaseParam1OfEffect(ieDword opcode, ieDword amount) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1714,6 +1747,9 @@ void EffectQueue::DecreaseParam1OfEffect(EffectRef &effect_reference, ieDword am
 //returns the damage amount NOT soaked
 int EffectQueue::DecreaseParam3OfEffect(ieDword opcode, ieDword amount, ieDword param2) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return amount;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1753,6 +1789,9 @@ static const int ids_stats[9]={IE_FACTION, IE_TEAM, IE_EA, IE_GENERAL, IE_RACE,
 //0,1 and 9 are only in GemRB
 int EffectQueue::BonusAgainstCreature(ieDword opcode, Actor *actor) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return 0;
+	}
 	int sum = 0;
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
@@ -1803,6 +1842,9 @@ int EffectQueue::BonusAgainstCreature(EffectRef &effect_reference, Actor *actor)
 
 int EffectQueue::BonusForParam2(ieDword opcode, ieDword param2) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return 0;
+	}
 	int sum = 0;
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
@@ -1825,6 +1867,9 @@ int EffectQueue::BonusForParam2(EffectRef &effect_reference, ieDword param2) con
 
 bool EffectQueue::WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return false;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1864,6 +1909,9 @@ void EffectQueue::AddWeaponEffects(EffectQueue *fxqueue, EffectRef &fx_ref) cons
 	}
 
 	ieDword opcode = fx_ref.opcode;
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	Point p(-1,-1);
 
 	std::list< Effect* >::const_iterator f;
@@ -1886,6 +1934,10 @@ int EffectQueue::SumDamageReduction(EffectRef &effect_reference, ieDword weaponE
 	int remaining = 0;
 	int count = 0;
 
+	if( !MayHaveOpcode(opcode)) {
+		return -1;
+	}
+
 	std::list< Effect* >::const_iterator f;
 	for (f = effects.begin(); f != effects.end(); f++) {
 		MATCH_OPCODE();
@@ -1910,6 +1962,9 @@ int EffectQueue::SumDamageReduction(EffectRef &effect_reference, ieDword weaponE
 //useful for immunity vs spell, can't use item, etc.
 Effect *EffectQueue::HasOpcodeWithResource(ieDword opcode, const ieResRef resource) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return NULL;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1936,6 +1991,9 @@ Effect *EffectQueue::HasEffectWithPower(EffectRef &effect_reference, ieDword pow
 
 Effect *EffectQueue::HasOpcodeWithPower(ieDword opcode, ieDword power) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return NULL;
+	}
 	std::list< Effect* >::const_iterator f;
 	for (f = effects.begin(); f != effects.end(); f++) {
 		MATCH_OPCODE();
@@ -1964,6 +2022,9 @@ Effect *EffectQueue::HasSource(const ieResRef Removed) const
 //used in contingency/sequencer code (cannot have the same contingency twice)
 Effect *EffectQueue::HasOpcodeWithSource(ieDword opcode, const ieResRef Removed) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return NULL;
+	}
 	std::list< Effect* >::const_iterator f;
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
 		MATCH_OPCODE();
@@ -1992,6 +2053,30 @@ bool EffectQueue::HasAnyDispellableEffect() const
 	return false;
 }
 
+bool EffectQueue::GetStaticSignature(ieDword &signature) const
+{
+	signature = 0;
+	std::list< Effect* >::const_iterator f;
+	for ( f = effects.begin(); f != effects.end(); f++ ) {
+		const Effect *fx = *f;
+		if( fx->Opcode >= MAX_EFFECTS || !(Opcodes[fx->Opcode].Flags & EFFECT_STATIC)) {
+			return false;
+		}
+		//not applied yet, expiring or changing the base stats
+		if( fx->FirstApply || DelayType(fx->TimingMode&0xff) != PERMANENT) {
+			return false;
+		}
+		if( fx->TimingMode == FX_DURATION_INSTANT_PERMANENT || fx->TimingMode == FX_DURATION_JUST_EXPIRED) {
+			return false;
+		}
+		signature = signature * 31 + fx->Opcode;
+		signature = signature * 31 + fx->TimingMode;
+		signature = signature * 31 + fx->Parameter1;
+		signature = signature * 31 + fx->Parameter2;
+	}
+	return true;
+}
+
 void EffectQueue::dump() const
 {
 	StringBuffer buffer;
@@ -2095,6 +2180,9 @@ Effect *EffectQueue::GetNextEffect(std::list< Effect* >::const_iterator &f) cons
 
 ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2, const char *resource) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return 0;
+	}
 	ieDword cnt = 0;
 
 	std::list< Effect* >::const_iterator f;
@@ -2115,6 +2203,9 @@ ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2
 
 void EffectQueue::ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y) const
 {
+	if( !MayHaveOpcode(opcode)) {
+		return;
+	}
 	std::list< Effect* >::const_iterator f;
 
 	for ( f = effects.begin(); f != effects.end(); f++ ) {
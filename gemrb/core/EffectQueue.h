@@ -167,7 +167,8 @@ enum EffectFlags {
 	EFFECT_NO_LEVEL_CHECK = 2,
 	EFFECT_NO_ACTOR = 4,
 	EFFECT_REINIT_ON_LOAD = 8,
-	EFFECT_PRESET_TARGET = 16
+	EFFECT_PRESET_TARGET = 16,
+	EFFECT_STATIC = 32 //reapplying gives the same result while the stats don't change
 };
 
 /** Initializes table of available spell Effects used by all the queues. */
@@ -194,6 +195,10 @@ private:
 	std::list< Effect* > effects;
 	/** Actor which is target of the Effects */
 	Scriptable* Owner;
+	/** One bit for each opcode that may be in the list. Bits are set when
+	 * an effect is added (or turns into another opcode) and only cleared
+	 * by Cleanup, so a clear bit means no such effect for sure */
+	mutable ieDword OpcodeMask[MAX_EFFECTS / 32];
 
 public:
 	EffectQueue();
@@ -283,6 +288,9 @@ public:
 	//int SpecificDamageBonus(ieDword damage_type) const;
 	int BonusForParam2(EffectRef &effect_reference, ieDword param2) const;
 	bool HasAnyDispellableEffect() const;
+	/** true if reapplying the queue can only give the same result again,
+	 * the signature changes with the effects and their parameters */
+	bool GetStaticSignature(ieDword &signature) const;
 	//getting summarised effects
 	int BonusAgainstCreature(EffectRef &effect_reference, Actor *actor) const;
 	//getting weapon immunity flag
@@ -331,6 +339,20 @@ private:
 	int BonusForParam2(ieDword opcode, ieDword param2) const;
 	int BonusAgainstCreature(ieDword opcode, Actor *actor) const;
 	bool WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const;
+	void MarkOpcode(ieDword opcode) const
+	{
+		if (opcode < MAX_EFFECTS) {
+			OpcodeMask[opcode / 32] |= 1u << (opcode & 31);
+		}
+	}
+	/** false if there is certainly no effect with this opcode in the queue */
+	bool MayHaveOpcode(ieDword opcode) const
+	{
+		if (opcode >= MAX_EFFECTS) {
+			return true;
+		}
+		return (OpcodeMask[opcode / 32] & (1u << (opcode & 31))) != 0;
+	}
 };
 
 }
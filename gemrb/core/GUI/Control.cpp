@@ -109,6 +109,7 @@ void Control::Draw(unsigned short x, unsigned short y)
 	video->SetScreenClip(&drawFrame);
 	DrawInternal(drawFrame);
 	video->SetScreenClip(&clip);
+	video->AddDirtyRect(drawFrame);
 	Changed = false; // set *after* calling DrawInternal
 }
 
@@ -99,6 +99,7 @@ void Window::DrawWindow()
 	if ( (Flags & (WF_FRAME|WF_CHANGED) ) == (WF_FRAME|WF_CHANGED) ) {
 		Region screen( 0, 0, core->Width, core->Height );
 		video->SetScreenClip( NULL );
+		video->InvalidateScreen();
 		//removed this?
 		video->DrawRect( screen, ColorBlack );
 		if (core->WindowFrames[0])
@@ -138,6 +139,7 @@ void Window::DrawWindow()
 	if ( (Flags&WF_CHANGED) && (Visible == WINDOW_GRAYED) ) {
 		Color black = { 0, 0, 0, 128 };
 		video->DrawRect(clip, black);
+		video->AddDirtyRect(clip);
 	}
 	video->SetScreenClip( NULL );
 	Flags &= ~WF_CHANGED;
@@ -151,8 +153,10 @@ void Window::DrawBackground(const Region* rgn) const
 		toClip.x += XPos;
 		toClip.y += YPos;
 		video->BlitSprite( BackGround, *rgn, toClip);
+		video->AddDirtyRect(toClip);
 	} else {
 		video->BlitSprite( BackGround, XPos, YPos, true );
+		video->AddDirtyRect(Region(XPos, YPos, Width, Height));
 	}
 }
 
@@ -260,6 +260,11 @@ void WorldMapControl::OnMouseOver(unsigned short x, unsigned short y)
 			Area=ae;
 			if(oldArea!=ae) {
 				RunEventHandler(WorldMapControlOnEnter);
+				//the player is likely to travel there next
+				Game* game = core->GetGame();
+				if (game) {
+					game->Prefetch(ae->AreaResRef);
+				}
 			}
 			break;
 		}
@@ -26,6 +26,7 @@
 #include "strrefs.h"
 #include "win32def.h"
 
+#include "AreaPrefetch.h"
 #include "DisplayMessage.h"
 #include "GameData.h"
 #include "Interface.h"
@@ -94,6 +95,7 @@ Game::Game(void) : Scriptable( ST_GLOBAL )
 	PartyGold = 0;
 	SetScript( core->GlobalScript, 0 );
 	MapIndex = -1;
+	prefetch = new AreaPrefetch();
 	Reputation = 0;
 	ControlStatus = 0;
 	CombatCounter = 0; //stored here until we know better
@@ -179,6 +181,7 @@ Game::~Game(void)
 	size_t i;
 
 	delete weather;
+	delete prefetch;
 	for (i = 0; i < Maps.size(); i++) {
 		delete( Maps[i] );
 	}
@@ -898,6 +901,7 @@ int Game::LoadMap(const char* ResRef, bool loadscreen)
 		return index;
 	}
 
+	unsigned long startTime = GetTickCount();
 	bool hide = false;
 	if (loadscreen && sE) {
 		hide = core->HideGCWindow();
@@ -939,6 +943,8 @@ int Game::LoadMap(const char* ResRef, bool loadscreen)
 	}
 	newMap->InitActors();
 
+	prefetch->Loaded(ResRef, GetTickCount() - startTime);
+
 	return ret;
 failedload:
 	if (hide) {
@@ -948,6 +954,19 @@ failedload:
 	return -1;
 }
 
+void Game::Prefetch(const char* ResRef)
+{
+	if (FindMap(ResRef) >= 0) {
+		return;
+	}
+	prefetch->Request(ResRef);
+}
+
+void Game::UpdatePrefetch()
+{
+	prefetch->Update();
+}
+
 // check if the actor is in npclevel.2da and replace accordingly
 bool Game::CheckForReplacementActor(int i)
 {
@@ -1495,6 +1514,8 @@ void Game::UpdateScripts()
 		Maps[idx]->UpdateScripts();
 	}
 
+	UpdatePrefetch();
+
 	if (PartyAttack) {
 		//ChangeSong will set the battlesong only if CombatCounter is nonzero
 		CombatCounter=150;
@@ -2144,6 +2165,9 @@ void Game::dump() const
 	int hours = GameTime/AI_UPDATE_TIME/300;
 	buffer.appendFormatted("Game time: %d (%d days, %d hours)\n", GameTime, hours/24, hours%24);
 	buffer.appendFormatted("CombatCounter: %d\n", (int) CombatCounter);
+	ieDword allocated, reused, spare;
+	Action::GetAllocStats(allocated, reused, spare);
+	buffer.appendFormatted("Actions allocated: %d   reused: %d   spare: %d\n", allocated, reused, spare);
 
 	buffer.appendFormatted("Party size: %d\n", (int) PCs.size());
 	for(idx=0;idx<PCs.size();idx++) {
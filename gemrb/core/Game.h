@@ -42,6 +42,7 @@
 namespace GemRB {
 
 class Actor;
+class AreaPrefetch;
 class Map;
 class Particles;
 class TableMgr;
@@ -310,6 +311,8 @@ private:
 	void LoadCRTable();
 	Actor *timestop_owner;
 	ieDword timestop_end;
+	/** reads ahead the area the party is likely to enter next */
+	AreaPrefetch *prefetch;
 public:
 	/** Returns the PC's slot count for partyID */
 	int FindPlayer(unsigned int partyID);
@@ -373,6 +376,9 @@ public:
 	 * don't load it again, set changepf == true,
 	 * if you want to change the pathfinder too. */
 	int LoadMap(const char* ResRef, bool loadscreen);
+	/** Asks for the resources of an area the party is likely to enter next
+	 * to be read ahead, they are read in small slices by UpdatePrefetch */
+	void Prefetch(const char* ResRef);
 	int DelMap(unsigned int index, int forced = 0);
 	int AddNPC(Actor* npc);
 	Actor* GetNPC(unsigned int Index);
@@ -510,6 +516,7 @@ private:
 	void CastOnRest();
 	void PlayerDream();
 	void TextDream();
+	void UpdatePrefetch();
 };
 
 }
@@ -2115,28 +2115,43 @@ void SetVariable(Scriptable* Sender, const char* VarName, ieDword value)
 	}
 }
 
-ieDword CheckVariable(Scriptable* Sender, const char* VarName, bool *valid)
+static inline void LookupVariable(const Variables *vars, const char *name, const VariableKey *key, ieDword &value)
 {
-	char newVarName[8];
-	const char *poi;
-	ieDword value = 0;
+	if (key) {
+		vars->Lookup( *key, value );
+	} else {
+		vars->Lookup( name, value );
+	}
+}
 
-	strlcpy( newVarName, VarName, 7 );
-	poi = &VarName[6];
+static const char *SkipScope(const char *VarName)
+{
+	const char *poi = &VarName[6];
 	//some HoW triggers use a : to separate the scope from the variable name
 	if (*poi==':') {
 		poi++;
 	}
+	return poi;
+}
+
+static ieDword CheckVariableKey(Scriptable* Sender, const char* VarName, const VariableKey *key, bool *valid)
+{
+	char newVarName[8];
+	const char *poi;
+	ieDword value = 0;
+
+	strlcpy( newVarName, VarName, 7 );
+	poi = SkipScope( VarName );
 
 	if (stricmp( newVarName, "MYAREA" ) == 0) {
-		Sender->GetCurrentArea()->locals->Lookup( poi, value );
+		LookupVariable( Sender->GetCurrentArea()->locals, poi, key, value );
 		if (InDebug&ID_VARIABLES) {
 			print("CheckVariable %s: %d", VarName, value);
 		}
 		return value;
 	}
 	if (stricmp( newVarName, "LOCALS" ) == 0) {
-		Sender->locals->Lookup( poi, value );
+		LookupVariable( Sender->locals, poi, key, value );
 		if (InDebug&ID_VARIABLES) {
 			print("CheckVariable %s: %d", VarName, value);
 		}
@@ -2144,7 +2159,7 @@ ieDword CheckVariable(Scriptable* Sender, const char* VarName, bool *valid)
 	}
 	Game *game = core->GetGame();
 	if (HasKaputz && !stricmp(newVarName,"KAPUTZ") ) {
-		game->kaputz->Lookup( poi, value );
+		LookupVariable( game->kaputz, poi, key, value );
 		if (InDebug&ID_VARIABLES) {
 			print("CheckVariable %s: %d", VarName, value);
 		}
@@ -2153,7 +2168,7 @@ ieDword CheckVariable(Scriptable* Sender, const char* VarName, bool *valid)
 	if (stricmp(newVarName,"GLOBAL") ) {
 		Map *map=game->GetMap(game->FindMap(newVarName));
 		if (map) {
-			map->locals->Lookup( poi, value);
+			LookupVariable( map->locals, poi, key, value );
 		} else {
 			if (valid) {
 				*valid=false;
@@ -2164,7 +2179,7 @@ ieDword CheckVariable(Scriptable* Sender, const char* VarName, bool *valid)
 			}
 		}
 	} else {
-		game->locals->Lookup( poi, value );
+		LookupVariable( game->locals, poi, key, value );
 	}
 	if (InDebug&ID_VARIABLES) {
 		print("CheckVariable %s: %d", VarName, value);
@@ -2172,6 +2187,22 @@ ieDword CheckVariable(Scriptable* Sender, const char* VarName, bool *valid)
 	return value;
 }
 
+ieDword CheckVariable(Scriptable* Sender, const char* VarName, bool *valid)
+{
+	return CheckVariableKey( Sender, VarName, NULL, valid );
+}
+
+//the variable names of triggers don't change, so their keys are kept
+ieDword CheckVariable(Scriptable* Sender, Trigger* parameters, int idx, bool *valid)
+{
+	const char *VarName = idx ? parameters->string1Parameter : parameters->string0Parameter;
+	VariableKey &key = parameters->varKeys[idx];
+	if (!key.IsSet()) {
+		key.Set( SkipScope( VarName ) );
+	}
+	return CheckVariableKey( Sender, VarName, &key, valid );
+}
+
 ieDword CheckVariable(Scriptable* Sender, const char* VarName, const char* Context, bool *valid)
 {
 	char newVarName[8];
@@ -28,11 +28,14 @@
 #include "Game.h"
 #include "GameData.h"
 #include "Interface.h"
+#include "Map.h"
 #include "PluginMgr.h"
 #include "TableMgr.h"
 #include "RNG/RNG_SFMT.h"
 #include "System/StringBuffer.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 //debug flags
@@ -42,6 +45,11 @@ namespace GemRB {
 // 8 - action execution
 //16 - trigger evaluation
 
+//number of trigger functions called, used for the script cost counters
+static ieDword TriggerCalls = 0;
+//bumped whenever the trigger tables change, compiled conditions check it
+static ieDword TriggerGeneration = 1;
+
 //Make this an ordered list, so we could use bsearch!
 static const TriggerLink triggernames[] = {
 	{"actionlistempty", GameScript::ActionListEmpty, 0},
@@ -137,25 +145,25 @@ static const TriggerLink triggernames[] = {
 	{"general", GameScript::General, 0},
 	{"ggt", GameScript::GGT_Trigger, 0},
 	{"glt", GameScript::GLT_Trigger, 0},
-	{"global", GameScript::Global,TF_MERGESTRINGS},
-	{"globalandglobal", GameScript::GlobalAndGlobal_Trigger,TF_MERGESTRINGS},
-	{"globalband", GameScript::BitCheck,TF_MERGESTRINGS},
-	{"globalbandglobal", GameScript::GlobalBAndGlobal_Trigger,TF_MERGESTRINGS},
-	{"globalbandglobalexact", GameScript::GlobalBAndGlobalExact,TF_MERGESTRINGS},
-	{"globalbitglobal", GameScript::GlobalBitGlobal_Trigger,TF_MERGESTRINGS},
-	{"globalequalsglobal", GameScript::GlobalsEqual,TF_MERGESTRINGS}, //this is the same
-	{"globalgt", GameScript::GlobalGT,TF_MERGESTRINGS},
-	{"globalgtglobal", GameScript::GlobalGTGlobal,TF_MERGESTRINGS},
-	{"globallt", GameScript::GlobalLT,TF_MERGESTRINGS},
-	{"globalltglobal", GameScript::GlobalLTGlobal,TF_MERGESTRINGS},
-	{"globalorglobal", GameScript::GlobalOrGlobal_Trigger,TF_MERGESTRINGS},
-	{"globalsequal", GameScript::GlobalsEqual, 0},
-	{"globalsgt", GameScript::GlobalsGT, 0},
-	{"globalslt", GameScript::GlobalsLT, 0},
-	{"globaltimerexact", GameScript::GlobalTimerExact, 0},
-	{"globaltimerexpired", GameScript::GlobalTimerExpired, 0},
-	{"globaltimernotexpired", GameScript::GlobalTimerNotExpired, 0},
-	{"globaltimerstarted", GameScript::GlobalTimerStarted, 0},
+	{"global", GameScript::Global,TF_MERGESTRINGS|TF_SHARED},
+	{"globalandglobal", GameScript::GlobalAndGlobal_Trigger,TF_MERGESTRINGS|TF_SHARED},
+	{"globalband", GameScript::BitCheck,TF_MERGESTRINGS|TF_SHARED},
+	{"globalbandglobal", GameScript::GlobalBAndGlobal_Trigger,TF_MERGESTRINGS|TF_SHARED},
+	{"globalbandglobalexact", GameScript::GlobalBAndGlobalExact,TF_MERGESTRINGS|TF_SHARED},
+	{"globalbitglobal", GameScript::GlobalBitGlobal_Trigger,TF_MERGESTRINGS|TF_SHARED},
+	{"globalequalsglobal", GameScript::GlobalsEqual,TF_MERGESTRINGS|TF_SHARED}, //this is the same
+	{"globalgt", GameScript::GlobalGT,TF_MERGESTRINGS|TF_SHARED},
+	{"globalgtglobal", GameScript::GlobalGTGlobal,TF_MERGESTRINGS|TF_SHARED},
+	{"globallt", GameScript::GlobalLT,TF_MERGESTRINGS|TF_SHARED},
+	{"globalltglobal", GameScript::GlobalLTGlobal,TF_MERGESTRINGS|TF_SHARED},
+	{"globalorglobal", GameScript::GlobalOrGlobal_Trigger,TF_MERGESTRINGS|TF_SHARED},
+	{"globalsequal", GameScript::GlobalsEqual, TF_SHARED},
+	{"globalsgt", GameScript::GlobalsGT, TF_SHARED},
+	{"globalslt", GameScript::GlobalsLT, TF_SHARED},
+	{"globaltimerexact", GameScript::GlobalTimerExact, TF_SHARED},
+	{"globaltimerexpired", GameScript::GlobalTimerExpired, TF_SHARED},
+	{"globaltimernotexpired", GameScript::GlobalTimerNotExpired, TF_SHARED},
+	{"globaltimerstarted", GameScript::GlobalTimerStarted, TF_SHARED},
 	{"gt", GameScript::GT, 0},
 	{"happiness", GameScript::Happiness, 0},
 	{"happinessgt", GameScript::HappinessGT, 0},
@@ -402,10 +410,10 @@ static const TriggerLink triggernames[] = {
 	{"systemvariable", GameScript::SystemVariable_Trigger, 0}, //gemrb
 	{"targetunreachable", GameScript::TargetUnreachable, 0},
 	{"team", GameScript::Team, 0},
-	{"time", GameScript::Time, 0},
-	{"timegt", GameScript::TimeGT, 0},
-	{"timelt", GameScript::TimeLT, 0},
-	{"timeofday", GameScript::TimeOfDay, 0},
+	{"time", GameScript::Time, TF_SHARED},
+	{"timegt", GameScript::TimeGT, TF_SHARED},
+	{"timelt", GameScript::TimeLT, TF_SHARED},
+	{"timeofday", GameScript::TimeOfDay, TF_SHARED},
 	{"timeractive", GameScript::TimerActive, 0},
 	{"timerexpired", GameScript::TimerExpired, 0},
 	{"timestopcounter", GameScript::TimeStopCounter, 0},
@@ -1217,6 +1225,60 @@ void SetScriptDebugMode(int arg)
 
 /********************** Targets **********************************/
 
+std::vector<targetlist> Targets::SpareLists;
+std::vector<void *> Targets::SpareObjects;
+
+Targets::Targets()
+{
+	//take over the storage of a previous list
+	if (!SpareLists.empty()) {
+		objects.swap(SpareLists.back());
+		SpareLists.pop_back();
+	}
+}
+
+Targets::~Targets()
+{
+	if (objects.capacity() && SpareLists.size() < MAX_SPARE_TARGETS) {
+		objects.clear();
+		SpareLists.push_back(targetlist());
+		SpareLists.back().swap(objects);
+	}
+}
+
+//freed blocks of a fixed size class, handed out again before the heap
+static void *PoolAlloc(std::vector<void *> &spare, size_t size)
+{
+	if (spare.empty()) {
+		return ::operator new(size);
+	}
+	void *ptr = spare.back();
+	spare.pop_back();
+	return ptr;
+}
+
+static void PoolFree(std::vector<void *> &spare, void *ptr, size_t max)
+{
+	if (!ptr) {
+		return;
+	}
+	if (spare.size() < max) {
+		spare.push_back(ptr);
+	} else {
+		::operator delete(ptr);
+	}
+}
+
+void *Targets::operator new(size_t size)
+{
+	return PoolAlloc(SpareObjects, size);
+}
+
+void Targets::operator delete(void *ptr)
+{
+	PoolFree(SpareObjects, ptr, MAX_SPARE_TARGETS);
+}
+
 int Targets::Count() const
 {
 	return (int)objects.size();
@@ -1233,10 +1295,10 @@ targettype *Targets::RemoveTargetAt(targetlist::iterator &m)
 
 const targettype *Targets::GetLastTarget(int Type)
 {
-	targetlist::const_iterator m = objects.end();
-	while (m--!=objects.begin() ) {
-		if ( (Type==-1) || ((*m).actor->Type==Type) ) {
-			return &(*(m));
+	size_t i = objects.size();
+	while (i--) {
+		if ( (Type==-1) || (objects[i].actor->Type==Type) ) {
+			return &objects[i];
 		}
 	}
 	return NULL;
@@ -1283,6 +1345,11 @@ Scriptable *Targets::GetTarget(unsigned int index, int Type)
 	return NULL;
 }
 
+static bool CloserTarget(const targettype &a, const targettype &b)
+{
+	return a.distance < b.distance;
+}
+
 //this stuff should be refined, dead actors are sometimes targetable by script?
 void Targets::AddTarget(Scriptable* target, unsigned int distance, int ga_flags)
 {
@@ -1307,14 +1374,9 @@ void Targets::AddTarget(Scriptable* target, unsigned int distance, int ga_flags)
 		break;
 	}
 	targettype Target = {target, distance};
-	targetlist::iterator m;
-	for (m = objects.begin(); m != objects.end(); ++m) {
-		if ( (*m).distance>distance) {
-			objects.insert( m, Target);
-			return;
-		}
-	}
-	objects.push_back( Target );
+	//after any others at the same distance
+	targetlist::iterator m = std::upper_bound(objects.begin(), objects.end(), Target, CloserTarget);
+	objects.insert( m, Target);
 }
 
 void Targets::Clear()
@@ -1780,6 +1842,7 @@ void InitializeIEScript()
 			triggerflags[i] |= TF_SAVED;
 		}
 	}
+	TriggerGeneration++;
 }
 
 /********************** GameScript *******************************/
@@ -1984,7 +2047,7 @@ static Condition* ReadCondition(DataStream* stream)
 		Trigger* tR = ReadTrigger( stream );
 		if (!tR)
 			break;
-		cO->triggers.push_back( tR );
+		cO->AddTrigger( tR );
 	}
 	return cO;
 }
@@ -2009,10 +2072,14 @@ bool GameScript::Update(bool *continuing, bool *done)
 	bool continueExecution = false;
 	if (continuing) continueExecution = *continuing;
 
+	script->Runs++;
 	RandomNumValue=RNG_SFMT::getInstance()->rand();
 	for (size_t a = 0; a < script->responseBlocks.size(); a++) {
 		ResponseBlock* rB = script->responseBlocks[a];
-		if (rB->condition->Evaluate(MySelf)) {
+		ieDword calls = TriggerCalls;
+		bool matched = rB->condition->Evaluate(MySelf);
+		AddCost(TriggerCalls - calls);
+		if (matched) {
 			//if this isn't a continue-d block, we have to clear the queue
 			//we cannot clear the queue and cannot execute the new block
 			//if we already have stuff on the queue!
@@ -2057,6 +2124,26 @@ bool GameScript::Update(bool *continuing, bool *done)
 	return continueExecution;
 }
 
+void GameScript::AddCost(ieDword calls)
+{
+	script->Cost += calls;
+	MySelf->ScriptCost += calls;
+	Map *map = MySelf->GetCurrentArea();
+	if (map) {
+		map->ScriptCost += calls;
+	}
+}
+
+void GameScript::GetCost(ieDword &runs, ieDword &cost) const
+{
+	if (script) {
+		runs = script->Runs;
+		cost = script->Cost;
+	} else {
+		runs = cost = 0;
+	}
+}
+
 //IE simply takes the first action's object for cutscene object
 //then adds these actions to its queue:
 // SetInterrupt(false), <actions>, SetInterrupt(true)
@@ -2227,18 +2314,105 @@ int GameScript::EvaluateString(Scriptable* Sender, char* String)
 	return 0;
 }
 
+static const char *GetTriggerName(unsigned short triggerID)
+{
+	const char *tmpstr=triggersTable->GetValue(triggerID);
+	if (!tmpstr) {
+		tmpstr=triggersTable->GetValue(triggerID|0x4000);
+	}
+	return tmpstr;
+}
+
+//resolves the trigger functions once, instead of on every evaluation
+//MYAREA and LOCALS variables belong to the sender, so they can't be shared
+static bool IsSenderScope(const char *var)
+{
+	return !strnicmp(var, "MYAREA", 6) || !strnicmp(var, "LOCALS", 6);
+}
+
+static bool IsShared(const Trigger *trigger)
+{
+	if (trigger->triggerID >= MAX_TRIGGERS || !(triggerflags[trigger->triggerID] & TF_SHARED)) {
+		return false;
+	}
+	return !IsSenderScope(trigger->string0Parameter) && !IsSenderScope(trigger->string1Parameter);
+}
+
+void Condition::Compile()
+{
+	program.clear();
+	program.reserve(triggers.size());
+	generation = TriggerGeneration;
+	for (size_t i = 0; i < triggers.size(); i++) {
+		TriggerOp op;
+		op.trigger = triggers[i];
+		op.func = op.trigger->GetFunction();
+		op.negate = (op.trigger->flags & TF_NEGATE) != 0;
+		op.shared = IsShared(op.trigger);
+		op.time = 0;
+		op.changes = 0;
+		op.result = -1;
+		program.push_back(op);
+	}
+}
+
+//the same condition is evaluated by every actor using a cached script,
+//so the result of a shared trigger is reused until something changes
+int Condition::EvaluateShared(TriggerOp &op, Scriptable* Sender)
+{
+	Game *game = core->GetGame();
+	Map *map = Sender->GetCurrentArea();
+	if (!game) {
+		return op.func( Sender, op.trigger );
+	}
+	if (op.result >= 0 && op.time == game->GameTime && op.changes == Variables::GetChanges()) {
+		if (map) map->TriggerHits++;
+		return op.result;
+	}
+	if (map) map->TriggerMisses++;
+	TriggerCalls++;
+	op.result = op.func( Sender, op.trigger );
+	//the trigger itself may have created a variable
+	op.time = game->GameTime;
+	op.changes = Variables::GetChanges();
+	return op.result;
+}
+
 bool Condition::Evaluate(Scriptable* Sender)
+{
+	ieQword profile = core->ProfileStart();
+	bool ret = EvaluateProgram(Sender);
+	core->ProfileEnd(PROFILE_TRIGGERS, profile);
+	return ret;
+}
+
+bool Condition::EvaluateProgram(Scriptable* Sender)
 {
 	int ORcount = 0;
 	unsigned int result = 0;
 	bool subresult = true;
 
-	for (size_t i = 0; i < triggers.size(); i++) {
-		Trigger* tR = triggers[i];
-		//do not evaluate triggers in an Or() block if one of them
-		//was already True()
-		if (!ORcount || !subresult) {
-			result = tR->Evaluate(Sender);
+	if (generation != TriggerGeneration) {
+		Compile();
+	}
+
+	for (size_t i = 0; i < program.size(); i++) {
+		const TriggerOp &op = program[i];
+		if (!op.func) {
+			result = 0;
+		} else {
+			if (InDebug&ID_TRIGGERS) {
+				Log(WARNING, "GameScript", "Executing trigger code: 0x%04x %s",
+					op.trigger->triggerID, GetTriggerName(op.trigger->triggerID) );
+			}
+			int ret;
+			if (op.shared) {
+				ret = EvaluateShared(program[i], Sender);
+			} else {
+				TriggerCalls++;
+				ret = op.func( Sender, op.trigger );
+			}
+			result = op.negate ? !ret : ret;
 		}
 		if (result > 1) {
 			//we started an Or() block
@@ -2253,11 +2427,19 @@ bool Condition::Evaluate(Scriptable* Sender)
 			continue;
 		}
 		if (ORcount) {
-			subresult |= ( result != 0 );
+			if (result) {
+				//the Or() block is true, jump past the rest of it
+				if (i + ORcount > program.size()) {
+					Log(WARNING, "GameScript", "Unfinished OR block encountered!");
+				}
+				i += ORcount - 1;
+				ORcount = 0;
+				continue;
+			}
 			if (--ORcount) {
 				continue;
 			}
-			result = subresult;
+			return 0;
 		}
 		if (!result) {
 			return 0;
@@ -2270,31 +2452,37 @@ bool Condition::Evaluate(Scriptable* Sender)
 	return 1;
 }
 
-/* this may return more than a boolean, in case of Or(x) */
-int Trigger::Evaluate(Scriptable* Sender)
+TriggerFunction Trigger::GetFunction()
 {
-	if (!this) {
-		Log(ERROR, "GameScript", "Trigger evaluation fails due to NULL trigger.");
-		return 0;
-	}
 	if (triggerID > MAX_TRIGGERS) {
 		Log(ERROR, "GameScript", "Corrupted (too high) trigger code: %d", triggerID);
-		return 0;
+		return NULL;
 	}
 	TriggerFunction func = triggers[triggerID];
-	const char *tmpstr=triggersTable->GetValue(triggerID);
-	if (!tmpstr) {
-		tmpstr=triggersTable->GetValue(triggerID|0x4000);
-	}
 	if (!func) {
 		triggers[triggerID] = GameScript::False;
+		TriggerGeneration++;
 		Log(WARNING, "GameScript", "Unhandled trigger code: 0x%04x %s",
-			triggerID, tmpstr );
+			triggerID, GetTriggerName(triggerID) );
+		return NULL;
+	}
+	return func;
+}
+
+/* this may return more than a boolean, in case of Or(x) */
+int Trigger::Evaluate(Scriptable* Sender)
+{
+	if (!this) {
+		Log(ERROR, "GameScript", "Trigger evaluation fails due to NULL trigger.");
+		return 0;
+	}
+	TriggerFunction func = GetFunction();
+	if (!func) {
 		return 0;
 	}
 	if (InDebug&ID_TRIGGERS) {
 		Log(WARNING, "GameScript", "Executing trigger code: 0x%04x %s",
-				triggerID, tmpstr );
+				triggerID, GetTriggerName(triggerID) );
 	}
 	int ret = func( Sender, this );
 	if (flags & TF_NEGATE) {
@@ -2617,6 +2805,34 @@ void Trigger::dump(StringBuffer& buffer) const
 	buffer.appendFormatted("\n");
 }
 
+/********************** Action **********************************/
+
+std::vector<void *> Action::SpareActions;
+ieDword Action::Allocated = 0;
+ieDword Action::Reused = 0;
+
+void *Action::operator new(size_t size)
+{
+	if (SpareActions.empty()) {
+		Allocated++;
+	} else {
+		Reused++;
+	}
+	return PoolAlloc(SpareActions, size);
+}
+
+void Action::operator delete(void *ptr)
+{
+	PoolFree(SpareActions, ptr, MAX_SPARE_ACTIONS);
+}
+
+void Action::GetAllocStats(ieDword &allocated, ieDword &reused, ieDword &spare)
+{
+	allocated = Allocated;
+	reused = Reused;
+	spare = (ieDword) SpareActions.size();
+}
+
 void Action::dump() const
 {
 	StringBuffer buffer;
@@ -136,20 +136,22 @@ struct targettype {
 	unsigned int distance;
 };
 
-typedef std::list<targettype> targetlist;
+//kept sorted by distance
+typedef std::vector<targettype> targetlist;
+
+//recycled target lists, object matching creates lots of short lived ones
+#define MAX_SPARE_TARGETS 64
 
 class GEM_EXPORT Targets {
 public:
-	Targets()
-	{
-	}
-
-	~Targets()
-	{
-		Clear();
-	}
+	Targets();
+	~Targets();
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
 private:
 	targetlist objects;
+	static std::vector<targetlist> SpareLists;
+	static std::vector<void *> SpareObjects;
 public:
 	int Count() const;
 	void dump() const;
@@ -212,6 +214,9 @@ public:
 	bool isNull();
 };
 
+class Trigger;
+typedef int (* TriggerFunction)(Scriptable*, Trigger*);
+
 class GEM_EXPORT Trigger : protected Canary {
 public:
 	Trigger()
@@ -234,6 +239,8 @@ public:
 		}
 	}
 	int Evaluate(Scriptable* Sender);
+	/** looks up the function implementing this trigger */
+	TriggerFunction GetFunction();
 public:
 	unsigned short triggerID;
 	int int0Parameter;
@@ -244,6 +251,8 @@ public:
 	char string0Parameter[65];
 	char string1Parameter[65];
 	Object* objectParameter;
+	//keys of the variables named by the string parameters, set on first use
+	VariableKey varKeys[2];
 
 public:
 	void dump() const;
@@ -255,8 +264,21 @@ public:
 	}
 };
 
+/** a trigger of a compiled condition, with its function already looked up */
+struct TriggerOp {
+	TriggerFunction func;
+	Trigger* trigger;
+	bool negate;
+	//sender independent triggers keep their last result, it stays valid
+	//until the game time or any variable changes
+	bool shared;
+	ieDword time, changes;
+	int result;
+};
+
 class GEM_EXPORT Condition : protected Canary {
 public:
+	Condition() : generation(0) {}
 	~Condition()
 	{
 		for (size_t c = 0; c < triggers.size(); ++c) {
@@ -271,10 +293,30 @@ public:
 		delete this;
 	}
 	bool Evaluate(Scriptable* Sender);
+	void AddTrigger(Trigger* trigger)
+	{
+		triggers.push_back(trigger);
+		Invalidate();
+	}
+	/** call after changing triggers directly, so the program is rebuilt */
+	void Invalidate()
+	{
+		generation = 0;
+	}
 public:
 	std::vector<Trigger*> triggers;
+private:
+	//flat copy of triggers, rebuilt when they or the trigger tables change
+	std::vector<TriggerOp> program;
+	ieDword generation;
+	void Compile();
+	bool EvaluateProgram(Scriptable* Sender);
+	int EvaluateShared(TriggerOp &op, Scriptable* Sender);
 };
 
+//freed actions kept for reuse, scripts generate new ones all the time
+#define MAX_SPARE_ACTIONS 256
+
 class GEM_EXPORT Action : protected Canary {
 public:
 	Action(bool autoFree)
@@ -316,7 +358,14 @@ public:
 	char string1Parameter[65];
 private:
 	int RefCount;
+	static std::vector<void *> SpareActions;
+	static ieDword Allocated, Reused;
 public:
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
+	/** heap allocations, allocations served from freed actions and their number */
+	static void GetAllocStats(ieDword &allocated, ieDword &reused, ieDword &spare);
+
 	int GetRef() {
 		return RefCount;
 	}
@@ -422,6 +471,11 @@ public:
 
 class GEM_EXPORT Script : protected Canary {
 public:
+	Script()
+	{
+		Runs = 0;
+		Cost = 0;
+	}
 	~Script()
 	{
 		for (unsigned int i = 0; i < responseBlocks.size(); i++) {
@@ -433,6 +487,9 @@ public:
 	}
 public:
 	std::vector<ResponseBlock*> responseBlocks;
+	//shared by all users of the script, to find the expensive ones
+	ieDword Runs;
+	ieDword Cost; //triggers evaluated
 public:
 	void Release()
 	{
@@ -440,7 +497,6 @@ public:
 	}
 };
 
-typedef int (* TriggerFunction)(Scriptable*, Trigger*);
 typedef void (* ActionFunction)(Scriptable*, Action*);
 typedef Targets* (* ObjectFunction)(Scriptable *, Targets*, int ga_flags);
 typedef int (* IDSFunction)(Actor *, int parameter);
@@ -449,6 +505,7 @@ typedef int (* IDSFunction)(Actor *, int parameter);
 #define TF_CONDITION    1 //this isn't a trigger, just a condition (0x4000)
 #define TF_SAVED        2 //trigger is in svtriobj.ids
 #define TF_MERGESTRINGS 8 //same value as actions' mergestring
+#define TF_SHARED       16 //result only depends on game variables and time, not the sender
 
 struct TriggerLink {
 	const char* Name;
@@ -534,6 +591,8 @@ public:
 		int ScriptLevel = 0, bool AIScript = false);
 	~GameScript();
 	const char *GetName() { return this?Name:"NONE\0\0\0\0"; }
+	/** number of runs and trigger evaluations of the script (all instances) */
+	void GetCost(ieDword &runs, ieDword &cost) const;
 	static void ExecuteString(Scriptable* Sender, const char* String);
 	static int EvaluateString(Scriptable* Sender, char* String);
 	static void ExecuteAction(Scriptable* Sender, Action* aC);
@@ -547,6 +606,7 @@ private: //Internal Functions
 	Response* ReadResponse(DataStream* stream);
 	Trigger* ReadTrigger(DataStream* stream);
 	static int InParty(Scriptable* Sender, Trigger* parameters, bool allowdead);
+	void AddCost(ieDword calls);
 private: //Internal variables
 	Scriptable* const MySelf;
 	ieResRef Name;
@@ -197,10 +197,23 @@ static Targets* EvaluateObject(Map *map, Scriptable* Sender, Object* oC, int ga_
 	Targets *tgts = NULL;
 
 	//we need to get a subset of actors from the large array
-	//if this gets slow, we will need some index tables
-	int i = map->GetActorCount(true);
-	while (i--) {
-		Actor *ac = map->GetActor(i, true);
+	//actors only see as far as their visual range (see DoObjectChecks),
+	//so we only need to look at the area grid around them
+	std::vector<Actor*> candidates;
+	if (Sender->Type == ST_ACTOR) {
+		int visualrange = ((Actor *) Sender)->Modified[IE_VISUALRANGE];
+		Region rgn((Sender->Pos.x/16 - visualrange)*16, (Sender->Pos.y/12 - visualrange)*12,
+			(visualrange*2+1)*16, (visualrange*2+1)*12);
+		map->GetActorsInRegion(rgn, candidates);
+	} else {
+		int i = map->GetActorCount(true);
+		while (i--) {
+			candidates.push_back(map->GetActor(i, true));
+		}
+	}
+
+	for (size_t i = 0; i < candidates.size(); i++) {
+		Actor *ac = candidates[i];
 		if (!ac) continue; // is this check really needed?
 		// don't return Sender in IDS targeting!
 		// unless it's pst, which relies on it in 3012cut2-3012cut7.bcs
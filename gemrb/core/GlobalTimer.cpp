@@ -151,10 +151,12 @@ void GlobalTimer::DoStep(int count)
 	video->MoveViewportTo(x,y);
 }
 
-bool GlobalTimer::Update()
+//the most game ticks run in one frame, past this the game slows down
+//instead of chasing a backlog it can't clear
+#define MAX_CATCHUP_TICKS 4
+
+ieDword GlobalTimer::Update()
 {
-	Map *map;
-	Game *game;
 	GameControl* gc;
 	unsigned long thisTime;
 	unsigned long advance;
@@ -169,44 +171,56 @@ bool GlobalTimer::Update()
 
 	if (!startTime) {
 		startTime = thisTime;
-		return false;
+		return 0;
 	}
 
 	advance = thisTime - startTime;
 	if ( advance < interval) {
-		return false;
+		return 0;
 	}
 	ieDword count = advance/interval;
 	DoStep(count);
 	DoFadeStep(count);
+	//keep the remainder, so the tick rate doesn't depend on the frame rate
+	if (count > MAX_CATCHUP_TICKS) {
+		count = MAX_CATCHUP_TICKS;
+		startTime = thisTime - advance%interval;
+	} else {
+		startTime += count*interval;
+	}
+	return count;
+}
+
+void GlobalTimer::Tick()
+{
+	Map *map;
+	Game *game;
+	GameControl* gc;
+
+	gc = core->GetGameControl();
 	if (!gc) {
-		goto end;
+		return;
 	}
 	game = core->GetGame();
 	if (!game) {
-		goto end;
+		return;
 	}
 	map = game->GetCurrentArea();
 	if (!map) {
-		goto end;
+		return;
 	}
 	//do spell effects expire in dialogs?
 	//if yes, then we should remove this condition
 	if (!(gc->GetDialogueFlags()&DF_IN_DIALOG) ) {
 		map->UpdateFog();
+		ieQword profile = core->ProfileStart();
 		map->UpdateEffects();
-		if (thisTime) {
-			//this measures in-world time (affected by effects, actions, etc)
-			game->AdvanceTime(1);
-		}
+		core->ProfileEnd(PROFILE_EFFECTS, profile);
+		//this measures in-world time (affected by effects, actions, etc)
+		game->AdvanceTime(1);
 	}
 	//this measures time spent in the game (including pauses)
-	if (thisTime) {
-		game->RealTime++;
-	}
-end:
-	startTime = thisTime;
-	return true;
+	game->RealTime++;
 }
 
 
@@ -63,7 +63,10 @@ public:
 public:
 	void Init();
 	void Freeze();
-	bool Update();
+	/** returns the number of game ticks due since the last call */
+	ieDword Update();
+	/** advances the current area and game time by one tick */
+	void Tick();
 	bool ViewportIsMoving();
 	void DoStep(int count);
 	void SetMoveViewPort(ieDword x, ieDword y, int spd, bool center);
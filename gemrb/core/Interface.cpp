@@ -201,6 +201,14 @@ Interface::Interface()
 	NumFingKboard = 3;
 	NumFingScroll = 2;
 	MouseFeedback = 0;
+	MaxFPS = 30;
+	TileCacheSize = 16;
+	RenderThreads = 1;
+	BenchmarkTicks = 0;
+	CheckStaticRefresh = false;
+	BenchmarkDone = 0;
+	BenchmarkStart = 0;
+	memset(ProfileTime, 0, sizeof(ProfileTime));
 	TooltipDelay = 100;
 	IgnoreOriginalINI = 0;
 	Bpp = 32;
@@ -1000,6 +1008,7 @@ void Interface::Main()
 				swprintf(fpsstring, sizeof(fpsstring)/sizeof(fpsstring[0]), L"%.3f fps", frames);
 			}
 			video->DrawRect( fpsRgn, ColorBlack );
+			video->AddDirtyRect( fpsRgn );
 			fps->Print( fpsRgn, String(fpsstring), palette,
 					   IE_FONT_ALIGN_LEFT | IE_FONT_ALIGN_MIDDLE | IE_FONT_SINGLE_LINE );
 		}
@@ -1313,9 +1322,19 @@ int Interface::Init(InterfaceConfig* config)
 	CONFIG_INT("NumFingKboard", NumFingKboard = );
 	CONFIG_INT("NumFingInfo", NumFingInfo = );
 	CONFIG_INT("MouseFeedback", MouseFeedback = );
+	CONFIG_INT("MaxFPS", MaxFPS = );
+	CONFIG_INT("TileCacheSize", TileCacheSize = );
+	CONFIG_INT("RenderThreads", RenderThreads = );
+	CONFIG_INT("BenchmarkTicks", BenchmarkTicks = );
+	CONFIG_INT("CheckStaticRefresh", CheckStaticRefresh = );
 
 #undef CONFIG_INT
 
+	// no frame limit when benchmarking
+	if (BenchmarkTicks > 0) {
+		MaxFPS = 0;
+	}
+
 #define CONFIG_STRING(key, var, default) \
 		value = config->GetValueForKey(key); \
 		if (value && value[0]) { \
@@ -1386,10 +1405,16 @@ int Interface::Init(InterfaceConfig* config)
 		value = NULL;
 
 	CONFIG_STRING("AudioDriver", AudioDriverName);
+	CONFIG_STRING("BenchmarkSave", BenchmarkSave);
 	CONFIG_STRING("VideoDriver", VideoDriverName);
 	CONFIG_STRING("Encoding", Encoding);
 #undef CONFIG_STRING
 
+	// benchmarks run headless, see SDLVideoDriver::Init for the video side
+	if (BenchmarkTicks > 0) {
+		AudioDriverName = "none";
+	}
+
 	value = config->GetValueForKey("ModPath");
 	if (value) {
 		for (char *path = strtok((char*)value,SPathListSeparator);
@@ -1906,6 +1931,17 @@ int Interface::Init(InterfaceConfig* config)
 	} else
 		console->SetCursor (cursor);
 
+	if (BenchmarkTicks > 0) {
+		// skip the menus and go straight to the game
+		Holder<SaveGame> sg = sgiterator->GetSaveGame(BenchmarkSave.c_str());
+		if (!sg) {
+			Log(FATAL, "Core", "Benchmark save '%s' not found.", BenchmarkSave.c_str());
+			return GEM_ERROR;
+		}
+		SetupLoadGame(sg, 0);
+		QuitFlag = QF_LOADGAME|QF_ENTERGAME;
+	}
+
 	Log(MESSAGE, "Core", "Core Initialization Complete!");
 	return GEM_OK;
 }
@@ -2931,16 +2967,30 @@ void Interface::GameLoop(void)
 		update_scripts = !(gc->GetDialogueFlags() & DF_FREEZE_SCRIPTS);
 	}
 
-	bool do_update = GSUpdate(update_scripts);
+	ieDword ticks = GSUpdate(update_scripts);
 
 	if (game) {
 		if ( gc && (game->selected.size() > 0) ) {
 			gc->ChangeMap(GetFirstSelectedPC(true), false);
 		}
+		//benchmarks run exactly one tick per frame, as fast as possible
+		if (BenchmarkTicks > 0) {
+			ticks = update_scripts ? 1 : 0;
+		}
 		//in multi player (if we ever get to it), only the server must call this
-		if (do_update) {
+		//run all the ticks that came due, so slow frames don't slow down the game
+		while (ticks-- && game) {
+			timer->Tick();
 			// the game object will run the area scripts as well
+			ieQword profile = ProfileStart();
 			game->UpdateScripts();
+			ProfileEnd(PROFILE_SCRIPTS, profile);
+			if (BenchmarkTicks > 0) {
+				BenchmarkTick();
+			}
+			if (QuitFlag) break;
+			gc = GetGameControl();
+			if (gc && (gc->GetDialogueFlags() & DF_FREEZE_SCRIPTS)) break;
 		}
 	}
 }
@@ -3019,6 +3069,7 @@ void Interface::DrawWindows(bool allow_delete)
 				shieldColor.a = 0xff;
 			}
 			video->DrawRect( Region( 0, 0, Width, Height ), shieldColor );
+			video->InvalidateScreen();
 			RedrawAll(); // wont actually have any effect until the modal window is dismissed.
 			modalShield = true;
 		}
@@ -3129,6 +3180,9 @@ void Interface::DrawTooltip ()
 		strx += TooltipMargin;
 	}
 	Region textr = Region( strx, y, strw, h );
+	// drawn over the finished frame, so the area has to be restored afterwards
+	video->AddDirtyRect(Region(x, y, w + w1 + w2, h));
+	video->AddDirtyRect(textr);
 
 	// clip drawing to the control bounds, then restore after drawing
 	Region oldclip = video->GetScreenClip();
@@ -3667,15 +3721,77 @@ bool Interface::InCutSceneMode() const
 	return false;
 }
 
+//microseconds, only differences are meaningful
+static ieQword GetProfileTime()
+{
+#ifdef WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER count;
+	if (!frequency.QuadPart) {
+		QueryPerformanceFrequency(&frequency);
+	}
+	QueryPerformanceCounter(&count);
+	return (ieQword) (count.QuadPart / frequency.QuadPart * 1000000 +
+		count.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (ieQword) tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
+}
+
+ieQword Interface::ProfileStart() const
+{
+	if (BenchmarkTicks <= 0) {
+		return 0;
+	}
+	return GetProfileTime();
+}
+
+void Interface::ProfileEnd(int section, ieQword start)
+{
+	if (BenchmarkTicks <= 0) {
+		return;
+	}
+	ProfileTime[section] += GetProfileTime() - start;
+}
+
+void Interface::BenchmarkTick()
+{
+	if (!BenchmarkDone++) {
+		BenchmarkStart = GetProfileTime();
+		memset(ProfileTime, 0, sizeof(ProfileTime));
+		return;
+	}
+	if (BenchmarkDone <= BenchmarkTicks) {
+		return;
+	}
+
+	//the first tick only started the clock
+	int ticks = BenchmarkTicks;
+	double total = (GetProfileTime() - BenchmarkStart) / 1000.0;
+	Log(MESSAGE, "Benchmark", "%d ticks in %.1f ms, %.1f ticks/sec at %dx%d, %d render thread(s)",
+		ticks, total, total > 0 ? ticks * 1000.0 / total : 0.0, Width, Height, RenderThreads);
+	static const char *names[PROFILE_COUNT] = { "scripts", "effects", "pathfinding", "projectiles", "area tiles", "wall covers",
+		"res lookups", "triggers", "sprite blits" };
+	for (int i = 0; i < PROFILE_COUNT; i++) {
+		double ms = ProfileTime[i] / 1000.0;
+		Log(MESSAGE, "Benchmark", "%-12s %9.1f ms  %7.3f ms/tick", names[i], ms, ms / ticks);
+	}
+	Log(MESSAGE, "Benchmark", "(scripts include the pathfinding they started and their triggers,");
+	Log(MESSAGE, "Benchmark", " resource lookups are also counted in the subsystem doing them)");
+	QuitFlag |= QF_KILL;
+}
+
 /** Updates the Game Script Engine State */
-bool Interface::GSUpdate(bool update_scripts)
+ieDword Interface::GSUpdate(bool update_scripts)
 {
 	if(update_scripts) {
 		return timer->Update();
 	}
 	else {
 		timer->Freeze();
-		return false;
+		return 0;
 	}
 }
 
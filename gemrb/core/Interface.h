@@ -216,6 +216,18 @@ enum MODAL_SHADOW {
 #define QF_ENTERGAME     16
 #define QF_KILL			32
 
+//subsystems timed in benchmark mode
+#define PROFILE_SCRIPTS     0
+#define PROFILE_EFFECTS     1
+#define PROFILE_PATHS       2
+#define PROFILE_PROJECTILES 3
+#define PROFILE_TILES       4
+#define PROFILE_COVERS      5
+#define PROFILE_RESOURCES   6
+#define PROFILE_TRIGGERS    7
+#define PROFILE_BLITS       8
+#define PROFILE_COUNT       9
+
 //events that are called out of drawwindow
 //they wait until the condition is right
 #define EF_CONTROL       1        //updates the game window statuses
@@ -326,6 +338,10 @@ private:
 	Holder<Audio> AudioDriver;
 	std::string VideoDriverName;
 	std::string AudioDriverName;
+	std::string BenchmarkSave;
+	int BenchmarkDone;
+	ieQword BenchmarkStart;
+	ieQword ProfileTime[PROFILE_COUNT];
 	ProjectileServer * projserv;
 
 	EventMgr * evntmgr;
@@ -543,8 +559,12 @@ public:
 	void SetCutSceneMode(bool active);
 	/** returns true if in cutscene mode */
 	bool InCutSceneMode() const;
-	/** Updates the Game Script Engine State */
-	bool GSUpdate(bool update_scripts);
+	/** Updates the Game Script Engine State, returns the game ticks to run */
+	ieDword GSUpdate(bool update_scripts);
+	/** in benchmark mode returns a timestamp for ProfileEnd, otherwise 0 */
+	ieQword ProfileStart() const;
+	/** adds the time since start to a subsystem */
+	void ProfileEnd(int section, ieQword start);
 	/** Get the Party INI Interpreter */
 	DataFileMgr * GetPartyINI() const
 	{
@@ -771,6 +791,7 @@ private:
 	GameControl* StartGameControl();
 	/** Executes everything (non graphical) in the main game loop */
 	void GameLoop(void);
+	void BenchmarkTick();
 	/** the internal (without cache) part of GetListFrom2DA */
 	ieDword *GetListFrom2DAInternal(const ieResRef resref);
 public:
@@ -805,6 +826,15 @@ public:
 	bool TouchScrollAreas, UseSoftKeyboard;
 	unsigned short NumFingScroll, NumFingKboard, NumFingInfo;
 	int MouseFeedback;
+	int MaxFPS;
+	//megabytes of converted area tiles kept by the video driver
+	int TileCacheSize;
+	//threads sharing the area tile drawing, 1 draws on the main thread only
+	int RenderThreads;
+	//run this many ticks of BenchmarkSave as fast as possible, then quit
+	int BenchmarkTicks;
+	//do the effect refreshes Actor::UpdateEffects skips and log differences
+	bool CheckStaticRefresh;
 	int GUIEnhancements;
 	int MaxPartySize;
 	bool KeepCache;
@@ -36,6 +36,7 @@
 #include "ImageMgr.h"
 #include "Palette.h"
 #include "Particles.h"
+#include "PathCache.h"
 #include "PathFinder.h"
 #include "PluginMgr.h"
 #include "Projectile.h"
@@ -65,6 +66,9 @@ namespace GemRB {
 
 #define ANI_PRI_BACKGROUND	-9999
 
+//number of remembered line of sight queries
+#define LOS_CACHE_SIZE 4096
+
 // TODO: fix this hardcoded resource reference
 static ieResRef PortalResRef={"EF03TPR3"};
 static unsigned int PortalTime = 15;
@@ -334,7 +338,20 @@ Map::Map(void)
 	HeightMap = NULL;
 	SmallMap = NULL;
 	MapSet = NULL;
+	MapSetStamp = NULL;
+	MapSetGeneration = 0;
 	SrchMap = NULL;
+	SightMap = NULL;
+	LOSCache = NULL;
+	LOSGeneration = 1;
+	FogGeneration = 0;
+	FogPass = 0;
+	TriggerHits = 0;
+	TriggerMisses = 0;
+	ScriptCost = 0;
+	PartyPresent = true;
+	Clusters = NULL;
+	CorridorSearch = false;
 	Walls = NULL;
 	WallCount = 0;
 	queue[PR_SCRIPT] = NULL;
@@ -374,8 +391,17 @@ Map::~Map(void)
 {
 	unsigned int i;
 
+	if (TriggerHits) {
+		Log(DEBUG, "Map", "%s: %u of %u shared trigger evaluations saved", scriptName,
+			TriggerHits, TriggerHits + TriggerMisses);
+	}
+
 	free( MapSet );
+	free( MapSetStamp );
 	free( SrchMap );
+	free( SightMap );
+	free( LOSCache );
+	delete Clusters;
 
 	//close the current container if it was owned by this map, this avoids a crash
 	Container *c = core->GetCurrentContainer();
@@ -468,15 +494,22 @@ void Map::AddTileMap(TileMap* tm, Image* lm, Bitmap* sr, Sprite2D* sm, Bitmap* h
 	Height = (unsigned int) (( TMap->YCellCount * 64 + 63) / 12);
 	//Filling Matrices
 	MapSet = (unsigned short *) malloc(sizeof(unsigned short) * Width * Height);
+	MapSetStamp = (ieDword *) calloc(Width * Height, sizeof(ieDword));
+	MapSetGeneration = 0;
 	//Internal Searchmap
 	int y = sr->GetHeight();
 	SrchMap = (unsigned short *) calloc(Width * Height, sizeof(unsigned short));
+	SightMap = (ieDword *) calloc((Width * Height + 31) / 32, sizeof(ieDword));
+	LOSCache = (LOSCacheEntry *) calloc(LOS_CACHE_SIZE, sizeof(LOSCacheEntry));
 	while(y--) {
 		int x=sr->GetWidth();
 		while(x--) {
 			SrchMap[y*Width+x] = Passable[sr->GetAt(x,y)&PATH_MAP_AREAMASK];
+			SetSightMap(y*Width+x, SrchMap[y*Width+x]);
 		}
 	}
+	Clusters = new PathCache(SrchMap, Width, Height);
+	ActorLookup.Resize(TMap->XCellCount * 64, TMap->YCellCount * 64);
 
 	//delete the original searchmap
 	delete sr;
@@ -665,6 +698,8 @@ void Map::UpdateScripts()
 			break;
 		}
 	}
+	PartyPresent = has_pcs;
+	ScriptCost = 0;
 
 	GenerateQueues();
 	SortQueues();
@@ -1211,7 +1246,9 @@ void Map::DrawMap(Region screen)
 			{
 				int drawn;
 				if (gametime>oldgametime) {
+					ieQword profile = core->ProfileStart();
 					drawn = pro->Update();
+					core->ProfileEnd(PROFILE_PROJECTILES, profile);
 				} else {
 					drawn = 1;
 				}
@@ -1350,7 +1387,7 @@ void Map::UpdateEffects()
 {
 	size_t i = actors.size();
 	while (i--) {
-		actors[i]->RefreshEffects(NULL);
+		actors[i]->UpdateEffects();
 	}
 }
 
@@ -1467,6 +1504,8 @@ void Map::InitActor(Actor *actor)
 	//guess game is always loaded? if not, then we'll crash
 	ieDword gametime = core->GetGame()->GameTime;
 
+	//the actor could have been placed or renamed before it knew its area
+	ActorLookup.Update(actor);
 	if (IsVisible(actor->Pos, false) && actor->Schedule(gametime, true) ) {
 		ActorSpottedByPlayer(actor);
 	}
@@ -1483,6 +1522,9 @@ void Map::AddActor(Actor* actor, bool init)
 	strnlwrcpy(actor->Area, scriptName, 8);
 	if (!HasActor(actor)) {
 		actors.push_back( actor );
+		ActorLookup.Add( actor );
+	} else {
+		ActorLookup.Update( actor );
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -1529,6 +1571,7 @@ void Map::DeleteActor(int i)
 		}
 	}
 	//remove the actor from the area's actor list
+	ActorLookup.Remove( actors[i] );
 	actors.erase( actors.begin()+i );
 }
 
@@ -1605,15 +1648,7 @@ Actor* Map::GetActorByGlobalID(ieDword objectID)
 	if (!objectID) {
 		return NULL;
 	}
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
-
-		if (actor->GetGlobalID()==objectID) {
-			return actor;
-		}
-	}
-	return NULL;
+	return ActorLookup.FindByGlobalID(objectID);
 }
 
 /** flags:
@@ -1624,9 +1659,15 @@ Actor* Map::GetActorByGlobalID(ieDword objectID)
 */
 Actor* Map::GetActor(const Point &p, int flags)
 {
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
+	//IsOver accepts points up to (size-1) search cells away
+	int reach = ActorLookup.GetMaxSize();
+	if (reach < 2) reach = 2;
+	Region rgn(p.x - (reach-1)*16, p.y - (reach-1)*12, (reach-1)*32+1, (reach-1)*24+1);
+	std::vector<Actor*> nearby;
+	ActorLookup.Query(rgn, nearby);
+
+	for (size_t i = 0; i < nearby.size(); i++) {
+		Actor* actor = nearby[i];
 
 		if (!actor->IsOver( p ))
 			continue;
@@ -1638,11 +1679,20 @@ Actor* Map::GetActor(const Point &p, int flags)
 	return NULL;
 }
 
+//the region holding every actor within radius of p, counting personal space
+static Region RadiusRegion(const Point &p, unsigned int radius, int maxsize)
+{
+	int reach = (int) radius + maxsize*10;
+	return Region(p.x - reach, p.y - reach, reach*2+1, reach*2+1);
+}
+
 Actor* Map::GetActorInRadius(const Point &p, int flags, unsigned int radius)
 {
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
+	std::vector<Actor*> nearby;
+	ActorLookup.Query(RadiusRegion(p, radius, ActorLookup.GetMaxSize()), nearby);
+
+	for (size_t i = 0; i < nearby.size(); i++) {
+		Actor* actor = nearby[i];
 
 		if (PersonalDistance( p, actor ) > radius)
 			continue;
@@ -1654,40 +1704,23 @@ Actor* Map::GetActorInRadius(const Point &p, int flags, unsigned int radius)
 	return NULL;
 }
 
-//maybe consider using a simple list
 Actor **Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, Scriptable *see)
 {
-	ieDword count = 1;
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
+	std::vector<Actor*> nearby;
+	ActorLookup.Query(RadiusRegion(p, radius, ActorLookup.GetMaxSize()), nearby);
 
-		if (PersonalDistance( p, actor ) > radius)
-			continue;
-		if (!actor->ValidTarget(flags, see) ) {
-			continue;
-		}
-		if (!(flags&GA_NO_LOS)) {
-			//line of sight visibility
-			if (!IsVisibleLOS(actor->Pos, p)) {
-				continue;
-			}
-		}
-		count++;
-	}
-
-	Actor **ret = (Actor **) malloc( sizeof(Actor*) * count);
-	i = actors.size();
+	Actor **ret = (Actor **) malloc( sizeof(Actor*) * (nearby.size()+1) );
 	int j = 0;
-	while (i--) {
-		Actor* actor = actors[i];
+	for (size_t i = 0; i < nearby.size(); i++) {
+		Actor* actor = nearby[i];
 
 		if (PersonalDistance( p, actor ) > radius)
 			continue;
-		if (!actor->ValidTarget(flags) ) {
+		if (!actor->ValidTarget(flags, see) ) {
 			continue;
 		}
 		if (!(flags&GA_NO_LOS)) {
+			//line of sight visibility
 			if (!IsVisibleLOS(actor->Pos, p)) {
 				continue;
 			}
@@ -1703,17 +1736,11 @@ Actor **Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius
 
 Actor* Map::GetActor(const char* Name, int flags)
 {
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
-		if (strnicmp( actor->GetScriptName(), Name, 32 ) == 0) {
-			if (!actor->ValidTarget(flags) ) {
-				return NULL;
-			}
-			return actor;
-		}
+	Actor* actor = ActorLookup.FindByName(Name);
+	if (actor && !actor->ValidTarget(flags) ) {
+		return NULL;
 	}
-	return NULL;
+	return actor;
 }
 
 int Map::GetActorCount(bool any) const
@@ -2037,6 +2064,7 @@ unsigned int Map::GetBlocked(const Point &c)
 SpriteCover* Map::BuildSpriteCover(int x, int y, int xpos, int ypos,
 	unsigned int width, unsigned int height, int flags, bool areaanim)
 {
+	ieQword profile = core->ProfileStart();
 	SpriteCover* sc = new SpriteCover;
 	sc->worldx = x;
 	sc->worldy = y;
@@ -2060,6 +2088,8 @@ SpriteCover* Map::BuildSpriteCover(int x, int y, int xpos, int ypos,
 
 		video->AddPolygonToSpriteCover(sc, wp);
 	}
+	sc->Finish();
+	core->ProfileEnd(PROFILE_COVERS, profile);
 
 	return sc;
 }
@@ -2313,13 +2343,22 @@ Entrance* Map::GetEntrance(const char* Name)
 
 bool Map::HasActor(Actor *actor)
 {
-	size_t i=actors.size();
-	while (i--) {
-		if (actors[i] == actor) {
-			return true;
-		}
-	}
-	return false;
+	return ActorLookup.Contains(actor);
+}
+
+void Map::UpdateActorIndex(Actor *actor)
+{
+	ActorLookup.Move(actor);
+}
+
+void Map::UpdateActorName(Actor *actor)
+{
+	ActorLookup.Rename(actor);
+}
+
+void Map::GetActorsInRegion(const Region &rgn, std::vector<Actor*> &result) const
+{
+	ActorLookup.Query(rgn, result);
 }
 
 void Map::RemoveActor(Actor* actor)
@@ -2332,6 +2371,7 @@ void Map::RemoveActor(Actor* actor)
 			ClearSearchMapFor(actor);
 			actor->SetMap(NULL);
 			CopyResRef(actor->Area, "");
+			ActorLookup.Remove( actor );
 			actors.erase( actors.begin()+i );
 			return;
 		}
@@ -2381,6 +2421,7 @@ void Map::dump(bool show_actors) const
 	buffer.appendFormatted( "Weather: %s\n", YESNO(AreaType & AT_WEATHER ) );
 	buffer.appendFormatted( "Area Type: %d\n", AreaType & (AT_CITY|AT_FOREST|AT_DUNGEON) );
 	buffer.appendFormatted( "Can rest: %s\n", YESNO(AreaType & AT_CAN_REST) );
+	buffer.appendFormatted( "Script cost of last tick: %d\n", ScriptCost );
 
 	if (show_actors) {
 		buffer.append("\n");
@@ -2396,6 +2437,44 @@ void Map::dump(bool show_actors) const
 
 /******************************************************************************/
 
+//long searches are first routed over the region graph and then only
+//expand the searchmap cells around that route
+bool Map::UseCorridor(const Point &start, const Point &goal)
+{
+	if (!Clusters->IsDistant(start, goal)) {
+		return false;
+	}
+	return Clusters->FindCorridor(start, goal);
+}
+
+//invalidates the previous search results without touching the whole MapSet
+void Map::ResetMapSet()
+{
+	MapSetGeneration++;
+	if (!MapSetGeneration) {
+		//wrapped around, old stamps could look valid again
+		memset( MapSetStamp, 0, Width * Height * sizeof( ieDword ) );
+		MapSetGeneration = 1;
+	}
+	while (InternalStack.size())
+		InternalStack.pop();
+	OpenList.clear();
+}
+
+inline unsigned int Map::GetMapSet(unsigned int pos) const
+{
+	if (MapSetStamp[pos] != MapSetGeneration) {
+		return 0;
+	}
+	return MapSet[pos];
+}
+
+inline void Map::SetMapSet(unsigned int pos, unsigned int value)
+{
+	MapSetStamp[pos] = MapSetGeneration;
+	MapSet[pos] = (unsigned short) value;
+}
+
 void Map::Leveldown(unsigned int px, unsigned int py,
 	unsigned int& level, Point &n, unsigned int& diff)
 {
@@ -2406,7 +2485,7 @@ void Map::Leveldown(unsigned int px, unsigned int py,
 		return;
 	} //walked off the map
 	pos = py * Width + px;
-	nlevel = MapSet[pos];
+	nlevel = GetMapSet(pos);
 	if (!nlevel) {
 		return;
 	} //not even considered
@@ -2429,18 +2508,103 @@ void Map::SetupNode(unsigned int x, unsigned int y, unsigned int size, unsigned
 	if (( x >= Width ) || ( y >= Height )) {
 		return;
 	}
+	if (CorridorSearch && !Clusters->InCorridor(x, y)) {
+		return;
+	}
 	pos = y * Width + x;
-	if (MapSet[pos]) {
+	if (GetMapSet(pos)) {
 		return;
 	}
 	if (GetBlocked(x*16+8,y*12+6,size)) {
-		MapSet[pos] = 65535;
+		SetMapSet(pos, 65535);
 		return;
 	}
-	MapSet[pos] = (ieWord) Cost;
+	SetMapSet(pos, Cost);
 	InternalStack.push( ( x << 16 ) | y );
 }
 
+//A* variant of SetupNode: nodes may be reopened if a cheaper way is found
+void Map::OpenNode(unsigned int x, unsigned int y, unsigned int size, unsigned int Cost, const Point &target)
+{
+	unsigned int pos;
+
+	if (( x >= Width ) || ( y >= Height )) {
+		return;
+	}
+	if (CorridorSearch && !Clusters->InCorridor(x, y)) {
+		return;
+	}
+	pos = y * Width + x;
+	unsigned int old = GetMapSet(pos);
+	if (old) {
+		//either blocked or already reached for less
+		if (old <= Cost) {
+			return;
+		}
+	} else if (GetBlocked(x*16+8,y*12+6,size)) {
+		SetMapSet(pos, 65535);
+		return;
+	}
+	SetMapSet(pos, Cost);
+
+	//the cheapest step is a diagonal one, so this never overestimates
+	unsigned int dx = (unsigned int) abs((int) x - target.x);
+	unsigned int dy = (unsigned int) abs((int) y - target.y);
+	PathOpenNode node;
+	node.cost = Cost;
+	node.total = Cost + NormalCost * (dx > dy ? dx : dy);
+	node.pos = ( x << 16 ) | y;
+	OpenList.push_back(node);
+	std::push_heap(OpenList.begin(), OpenList.end());
+}
+
+//runs A* from 'from' until 'to' is reached, leaving the costs in MapSet
+//so the path can be traced back from 'to' with Leveldown
+bool Map::SearchPath(const Point &from, const Point &to, unsigned int size)
+{
+	ResetMapSet();
+
+	unsigned int target = ( to.x << 16 ) | to.y;
+
+	SetMapSet(from.y * Width + from.x, 1);
+	PathOpenNode node;
+	node.cost = 1;
+	node.total = 1;
+	node.pos = ( from.x << 16 ) | from.y;
+	OpenList.push_back(node);
+
+	while (OpenList.size()) {
+		std::pop_heap(OpenList.begin(), OpenList.end());
+		node = OpenList.back();
+		OpenList.pop_back();
+		unsigned int x = node.pos >> 16;
+		unsigned int y = node.pos & 0xffff;
+
+		if (node.cost != GetMapSet(y * Width + x)) {
+			//superseded by a cheaper entry
+			continue;
+		}
+		if (node.pos == target) {
+			return true;
+		}
+		unsigned int Cost = node.cost + NormalCost;
+		if (Cost > 65500) {
+			continue;
+		}
+		OpenNode( x - 1, y - 1, size, Cost, to );
+		OpenNode( x + 1, y - 1, size, Cost, to );
+		OpenNode( x + 1, y + 1, size, Cost, to );
+		OpenNode( x - 1, y + 1, size, Cost, to );
+
+		Cost += AdditionalCost;
+		OpenNode( x, y - 1, size, Cost, to );
+		OpenNode( x + 1, y, size, Cost, to );
+		OpenNode( x, y + 1, size, Cost, to );
+		OpenNode( x - 1, y, size, Cost, to );
+	}
+	return false;
+}
+
 bool Map::AdjustPositionX(Point &goal, unsigned int radiusx, unsigned int radiusy)
 {
 	unsigned int minx = 0;
@@ -2543,16 +2707,14 @@ PathNode* Map::RunAway(const Point &s, const Point &d, unsigned int size, unsign
 		PathLen = 65535;
 	}
 
-	memset( MapSet, 0, Width * Height * sizeof( unsigned short ) );
-	while (InternalStack.size())
-		InternalStack.pop();
+	ResetMapSet();
 
 	if (!( GetBlocked( start.x, start.y) & PATH_MAP_PASSABLE )) {
 		AdjustPosition( start );
 	}
 	unsigned int pos = ( start.x << 16 ) | start.y;
 	InternalStack.push( pos );
-	MapSet[start.y * Width + start.x] = 1;
+	SetMapSet(start.y * Width + start.x, 1);
 	dist = 0;
 	Point best = start;
 	while (InternalStack.size()) {
@@ -2569,7 +2731,7 @@ PathNode* Map::RunAway(const Point &s, const Point &d, unsigned int size, unsign
 			dist=distance;
 		}
 
-		unsigned int Cost = MapSet[y * Width + x] + NormalCost;
+		unsigned int Cost = GetMapSet(y * Width + x) + NormalCost;
 		if (Cost > PathLen) {
 			break;
 		}
@@ -2603,7 +2765,7 @@ PathNode* Map::RunAway(const Point &s, const Point &d, unsigned int size, unsign
 		StartNode->Parent = Return;
 		Return->Next = StartNode;
 		StartNode = Return;
-		unsigned int level = MapSet[pos];
+		unsigned int level = GetMapSet(pos);
 		unsigned int diff = 0;
 		Point n;
 		Leveldown( p.x, p.y + 1, level, n, diff );
@@ -2635,9 +2797,6 @@ bool Map::TargetUnreachable(const Point &s, const Point &d, unsigned int size)
 {
 	Point start( s.x/16, s.y/12 );
 	Point goal ( d.x/16, d.y/12 );
-	memset( MapSet, 0, Width * Height * sizeof( unsigned short ) );
-	while (InternalStack.size())
-		InternalStack.pop();
 
 	if (GetBlocked( d.x, d.y, size )) {
 		return true;
@@ -2646,27 +2805,7 @@ bool Map::TargetUnreachable(const Point &s, const Point &d, unsigned int size)
 		return true;
 	}
 
-	unsigned int pos = ( goal.x << 16 ) | goal.y;
-	unsigned int pos2 = ( start.x << 16 ) | start.y;
-	InternalStack.push( pos );
-	MapSet[goal.y * Width + goal.x] = 1;
-
-	while (InternalStack.size() && pos!=pos2) {
-		pos = InternalStack.front();
-		InternalStack.pop();
-		unsigned int x = pos >> 16;
-		unsigned int y = pos & 0xffff;
-
-		SetupNode( x - 1, y - 1, size, 1 );
-		SetupNode( x + 1, y - 1, size, 1 );
-		SetupNode( x + 1, y + 1, size, 1 );
-		SetupNode( x - 1, y + 1, size, 1 );
-		SetupNode( x, y - 1, size, 1 );
-		SetupNode( x + 1, y, size, 1 );
-		SetupNode( x, y + 1, size, 1 );
-		SetupNode( x - 1, y, size, 1 );
-	}
-	return pos!=pos2;
+	return !SearchPath(goal, start, size);
 }
 
 /* Use this function when you target something by a straight line projectile (like a lightning bolt, arrow, etc)
@@ -2761,31 +2900,17 @@ PathNode* Map::GetLine(const Point &start, const Point &dest, int Speed, int Ori
 	return Return;
 }
 
-/*
- * find a path from start to goal, ending at the specified distance from the
- * target (the goal must be in sight of the end, if 'sight' is specified)
- *
- * if you don't need to find an optimal path near the goal then use FindPath
- * instead, but don't change this one without testing with combat and dialog,
- * you can't predict the goal point for those, you *must* path!
- */
-PathNode* Map::FindPathNear(const Point &s, const Point &d, unsigned int size, unsigned int MinDistance, bool sight)
+//the flood fill behind FindPathNear, goal is updated if we stop short of it
+bool Map::SearchPathNear(const Point &start, Point &goal, const Point &d, unsigned int size, unsigned int MinDistance, bool sight)
 {
-	// adjust the start/goal points to be searchmap locations
-	Point start( s.x/16, s.y/12 );
-	Point goal ( d.x/16, d.y/12 );
-	Point orig_goal = goal;
-
 	// re-initialise the path finding structures
-	memset( MapSet, 0, Width * Height * sizeof( unsigned short ) );
-	while (InternalStack.size())
-		InternalStack.pop();
+	ResetMapSet();
 
 	// set the start point in the path finding structures
 	unsigned int pos2 = ( goal.x << 16 ) | goal.y;
 	unsigned int pos = ( start.x << 16 ) | start.y;
 	InternalStack.push( pos );
-	MapSet[start.y * Width + start.x] = 1;
+	SetMapSet(start.y * Width + start.x, 1);
 
 	unsigned int squaredmindistance = MinDistance * MinDistance;
 	bool found_path = false;
@@ -2824,7 +2949,7 @@ PathNode* Map::FindPathNear(const Point &s, const Point &d, unsigned int size, u
 			}
 		}
 
-		unsigned int Cost = MapSet[y * Width + x] + NormalCost;
+		unsigned int Cost = GetMapSet(y * Width + x) + NormalCost;
 		if (Cost > 65500) {
 			// cost is far too high, no path found
 			break;
@@ -2844,6 +2969,36 @@ PathNode* Map::FindPathNear(const Point &s, const Point &d, unsigned int size, u
 		SetupNode( x - 1, y, size, Cost );
 	}
 
+	return found_path;
+}
+
+/*
+ * find a path from start to goal, ending at the specified distance from the
+ * target (the goal must be in sight of the end, if 'sight' is specified)
+ *
+ * if you don't need to find an optimal path near the goal then use FindPath
+ * instead, but don't change this one without testing with combat and dialog,
+ * you can't predict the goal point for those, you *must* path!
+ */
+PathNode* Map::FindPathNear(const Point &s, const Point &d, unsigned int size, unsigned int MinDistance, bool sight)
+{
+	// adjust the start/goal points to be searchmap locations
+	Point start( s.x/16, s.y/12 );
+	Point goal ( d.x/16, d.y/12 );
+	Point orig_goal = goal;
+
+	ieQword profile = core->ProfileStart();
+	bool found_path = false;
+	if (UseCorridor(start, goal)) {
+		CorridorSearch = true;
+		found_path = SearchPathNear(start, goal, d, size, MinDistance, sight);
+		CorridorSearch = false;
+	}
+	if (!found_path) {
+		found_path = SearchPathNear(start, goal, d, size, MinDistance, sight);
+	}
+	core->ProfileEnd(PROFILE_PATHS, profile);
+
 	// find path from goal to start
 	PathNode* StartNode = new PathNode;
 	PathNode* Return = StartNode;
@@ -2869,9 +3024,10 @@ PathNode* Map::FindPathNear(const Point &s, const Point &d, unsigned int size, u
 		StartNode->orient = GetOrient( goal, start );
 	}
 	Point p = goal;
-	pos2 = start.y * Width + start.x;
+	unsigned int pos;
+	unsigned int pos2 = start.y * Width + start.x;
 	while (( pos = p.y * Width + p.x ) != pos2) {
-		unsigned int level = MapSet[pos];
+		unsigned int level = GetMapSet(pos);
 		unsigned int diff = 0;
 		Point n;
 		Leveldown( p.x, p.y + 1, level, n, diff );
@@ -2908,45 +3064,22 @@ PathNode* Map::FindPath(const Point &s, const Point &d, unsigned int size, int M
 {
 	Point start( s.x/16, s.y/12 );
 	Point goal ( d.x/16, d.y/12 );
-	memset( MapSet, 0, Width * Height * sizeof( unsigned short ) );
-	while (InternalStack.size())
-		InternalStack.pop();
 
 	if (GetBlocked( d.x, d.y, size )) {
 		AdjustPosition( goal );
 	}
-	unsigned int pos = ( goal.x << 16 ) | goal.y;
-	unsigned int pos2 = ( start.x << 16 ) | start.y;
-	InternalStack.push( pos );
-	MapSet[goal.y * Width + goal.x] = 1;
-
-	while (InternalStack.size()) {
-		pos = InternalStack.front();
-		InternalStack.pop();
-		unsigned int x = pos >> 16;
-		unsigned int y = pos & 0xffff;
-
-		if (pos == pos2) {
-			//We've found _a_ path
-			//print("GOAL!!!");
-			break;
-		}
-		unsigned int Cost = MapSet[y * Width + x] + NormalCost;
-		if (Cost > 65500) {
-			//print("Path not found!");
-			break;
-		}
-		SetupNode( x - 1, y - 1, size, Cost );
-		SetupNode( x + 1, y - 1, size, Cost );
-		SetupNode( x + 1, y + 1, size, Cost );
-		SetupNode( x - 1, y + 1, size, Cost );
-
-		Cost += AdditionalCost;
-		SetupNode( x, y - 1, size, Cost );
-		SetupNode( x + 1, y, size, Cost );
-		SetupNode( x, y + 1, size, Cost );
-		SetupNode( x - 1, y, size, Cost );
+	//search backwards, so the costs lead from the start to the goal
+	ieQword profile = core->ProfileStart();
+	bool found = false;
+	if (UseCorridor(goal, start)) {
+		CorridorSearch = true;
+		found = SearchPath(goal, start, size);
+		CorridorSearch = false;
 	}
+	if (!found) {
+		found = SearchPath(goal, start, size);
+	}
+	core->ProfileEnd(PROFILE_PATHS, profile);
 
 	//find path from start to goal
 	PathNode* StartNode = new PathNode;
@@ -2956,17 +3089,18 @@ PathNode* Map::FindPath(const Point &s, const Point &d, unsigned int size, int M
 	StartNode->x = start.x;
 	StartNode->y = start.y;
 	StartNode->orient = GetOrient( goal, start );
-	if (pos != pos2) {
+	if (!found) {
 		return Return;
 	}
 	Point p = start;
-	pos2 = goal.y * Width + goal.x;
+	unsigned int pos;
+	unsigned int pos2 = goal.y * Width + goal.x;
 	while (( pos = p.y * Width + p.x ) != pos2) {
 		StartNode->Next = new PathNode;
 		StartNode->Next->Parent = StartNode;
 		StartNode = StartNode->Next;
 		StartNode->Next = NULL;
-		unsigned int level = MapSet[pos];
+		unsigned int level = GetMapSet(pos);
 		unsigned int diff = 0;
 		Point n;
 		Leveldown( p.x, p.y + 1, level, n, diff );
@@ -3025,62 +3159,100 @@ bool Map::IsVisible(const Point &pos, int explored)
 	return (VisibleBitmap[by] & bi)!=0;
 }
 
-//point a is visible from point b (searchmap)
-bool Map::IsVisibleLOS(const Point &s, const Point &d)
+inline bool Map::BlocksSight(int x, int y) const
 {
-	int sX=s.x/16;
-	int sY=s.y/12;
-	int dX=d.x/16;
-	int dY=d.y/12;
-	int diffx = sX - dX;
-	int diffy = sY - dY;
-
-	// we basically draw a 'line' from (sX, sY) to (dX, dY)
-	// we want to move along the larger axis, to make sure we don't miss anything
-	if (abs( diffx ) >= abs( diffy )) {
-		// (sX - startX)/elevationy = (sX - startX)/fabs(diffx) * diffy
-		double elevationy = fabs((double)diffx ) / diffy;
-		if (sX > dX) {
-			// right to left
-			for (int startx = sX; startx >= dX; startx--) {
-				// sX - startx >= 0, so subtract (due to sign of diffy)
-				//if (GetBlocked( startx, sY - ( int ) ( ( sX - startx ) / elevationy ) ) & PATH_MAP_NO_SEE)
-				if (GetBlocked( startx, sY - ( int ) ( ( sX - startx ) / elevationy ) ) & PATH_MAP_SIDEWALL)
-					return false;
-			}
-		} else {
-			// left to right
-			for (int startx = sX; startx <= dX; startx++) {
-				// sX - startx <= 0, so add (due to sign of diffy)
-				//if (GetBlocked( startx, sY + ( int ) ( ( sX - startx ) / elevationy ) ) & PATH_MAP_NO_SEE)
-				if (GetBlocked( startx, sY + ( int ) ( ( sX - startx ) / elevationy ) ) & PATH_MAP_SIDEWALL)
-					return false;
+	if ((unsigned) x >= Width || (unsigned) y >= Height) {
+		return false;
+	}
+	unsigned int pos = y*Width+x;
+	return (SightMap[pos>>5] >> (pos&31)) & 1;
+}
+
+//keeps the sight bit of a searchmap cell in sync, opaque doors are sidewalls too
+//(see GetBlocked); a change outdates every cached line of sight
+void Map::SetSightMap(unsigned int pos, unsigned int value)
+{
+	ieDword bit = 1u << (pos&31);
+	bool blocks = (value & (PATH_MAP_SIDEWALL|PATH_MAP_DOOR_OPAQUE)) != 0;
+	if (blocks == ((SightMap[pos>>5] & bit) != 0)) {
+		return;
+	}
+	if (blocks) {
+		SightMap[pos>>5] |= bit;
+	} else {
+		SightMap[pos>>5] &= ~bit;
+	}
+	LOSGeneration++;
+	if (!LOSGeneration) {
+		memset( LOSCache, 0, LOS_CACHE_SIZE * sizeof( LOSCacheEntry ) );
+		LOSGeneration = 1;
+	}
+}
+
+// we basically draw a 'line' from (sX, sY) to (dX, dY)
+// we move along the larger axis, to make sure we don't miss anything,
+// the other coordinate is sY + (k * diffy / diffx) truncated, like it
+// always was, but without going through floating point
+bool Map::TraceLOS(int sX, int sY, int dX, int dY) const
+{
+	int diffx = abs(dX - sX);
+	int diffy = abs(dY - sY);
+	int stepx = dX < sX ? -1 : 1;
+	int stepy = dY < sY ? -1 : 1;
+	int x = sX;
+	int y = sY;
+	int acc = 0;
+
+	if (diffx >= diffy) {
+		for (int k = 0; k <= diffx; k++, x += stepx) {
+			if (BlocksSight(x, y))
+				return false;
+			acc += diffy;
+			if (acc >= diffx) {
+				acc -= diffx;
+				y += stepy;
 			}
 		}
 	} else {
-		// (sY - startY)/elevationx = (sY - startY)/fabs(diffy) * diffx
-		double elevationx = fabs((double)diffy ) / diffx;
-		if (sY > dY) {
-			// bottom to top
-			for (int starty = sY; starty >= dY; starty--) {
-				// sY - starty >= 0, so subtract (due to sign of diffx)
-				//if (GetBlocked( sX - ( int ) ( ( sY - starty ) / elevationx ), starty ) & PATH_MAP_NO_SEE)
-				if (GetBlocked( sX - ( int ) ( ( sY - starty ) / elevationx ), starty ) & PATH_MAP_SIDEWALL)
-					return false;
-			}
-		} else {
-			// top to bottom
-			for (int starty = sY; starty <= dY; starty++) {
-				// sY - starty <= 0, so add (due to sign of diffx)
-				//if (GetBlocked( sX + ( int ) ( ( sY - starty ) / elevationx ), starty ) & PATH_MAP_NO_SEE)
-				if (GetBlocked( sX + ( int ) ( ( sY - starty ) / elevationx ), starty ) & PATH_MAP_SIDEWALL)
-					return false;
+		for (int k = 0; k <= diffy; k++, y += stepy) {
+			if (BlocksSight(x, y))
+				return false;
+			acc += diffx;
+			if (acc >= diffy) {
+				acc -= diffy;
+				x += stepx;
 			}
 		}
 	}
 	return true;
 }
 
+//point a is visible from point b (searchmap)
+bool Map::IsVisibleLOS(const Point &s, const Point &d)
+{
+	int sX=s.x/16;
+	int sY=s.y/12;
+	int dX=d.x/16;
+	int dY=d.y/12;
+
+	if (sX == dX && sY == dY) {
+		return true;
+	}
+
+	ieDword from = ((ieDword) (sY & 0xffff) << 16) | (sX & 0xffff);
+	ieDword to = ((ieDword) (dY & 0xffff) << 16) | (dX & 0xffff);
+	LOSCacheEntry &entry = LOSCache[((from * 2654435761u) ^ (to * 40503u)) % LOS_CACHE_SIZE];
+	if (entry.generation == LOSGeneration && entry.from == from && entry.to == to) {
+		return entry.visible;
+	}
+
+	entry.from = from;
+	entry.to = to;
+	entry.generation = LOSGeneration;
+	entry.visible = TraceLOS(sX, sY, dX, dY);
+	return entry.visible;
+}
+
 //returns direction of area boundary, returns -1 if it isn't a boundary
 int Map::WhichEdge(const Point &s)
 {
@@ -3367,13 +3539,56 @@ void Map::ExploreTile(const Point &pos)
 	VisibleBitmap[by] |= bi;
 }
 
-void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+//sets the bits first..last (inclusive) of a fog bitmap
+static void SetFogBits(ieByte *bitmap, unsigned int first, unsigned int last)
+{
+	unsigned int fb = first/8;
+	unsigned int lb = last/8;
+	ieByte fm = (ieByte) (0xff << (first%8));
+	ieByte lm = (ieByte) (0xff >> (7 - last%8));
+
+	if (fb == lb) {
+		bitmap[fb] |= fm & lm;
+		return;
+	}
+	bitmap[fb] |= fm;
+	if (lb > fb+1) {
+		memset(bitmap+fb+1, 0xff, lb-fb-1);
+	}
+	bitmap[lb] |= lm;
+}
+
+void Map::ExploreSpans(const std::vector<FogSpan> &spans)
+{
+	int w = TMap->XCellCount * 2 + LargeFog;
+	for (size_t i = 0; i < spans.size(); i++) {
+		const FogSpan &span = spans[i];
+		SetFogBits(ExploredBitmap, span.y*w + span.x1, span.y*w + span.x2);
+		SetFogBits(VisibleBitmap, span.y*w + span.x1, span.y*w + span.x2);
+	}
+}
+
+//casts the visibility rays from Pos, collecting the fog tiles they reach
+//in a scratch grid around Pos, then packs them into row spans
+void Map::TraceVisibility(const Point &Pos, int range, int los, std::vector<FogSpan> &spans)
 {
 	Point Tile;
 
+	spans.clear();
 	if (range>MaxVisibility) {
 		range=MaxVisibility;
 	}
+	int w = TMap->XCellCount * 2 + LargeFog;
+	int h = TMap->YCellCount * 2 + LargeFog;
+	//how far the rays can get from the tile of Pos, in fog tiles
+	int reachx = (MaxVisibility * 16 + 16) / 32 + 2;
+	int reachy = (MaxVisibility * 12 + 12) / 32 + 2;
+	int gw = reachx * 2 + 1;
+	int gh = reachy * 2 + 1;
+	int ox = Pos.x/32 - reachx;
+	int oy = Pos.y/32 - reachy;
+	FogScratch.assign(gw * gh, 0);
+
 	int p=VisibilityPerimeter;
 	while (p--) {
 		int Pass = 2;
@@ -3400,11 +3615,35 @@ void Map::ExploreMapChunk(const Point &Pos, int range, int los)
 					if (!Pass) break;
 				}
 			}
-			ExploreTile(Tile);
+			int x = Tile.x/32;
+			int y = Tile.y/32;
+			if (x < 0 || x >= w || y < 0 || y >= h)
+				continue;
+			FogScratch[(y - oy) * gw + x - ox] = 1;
+		}
+	}
+
+	for (int gy = 0; gy < gh; gy++) {
+		const ieByte *row = &FogScratch[gy * gw];
+		for (int gx = 0; gx < gw; gx++) {
+			if (!row[gx]) continue;
+			FogSpan span;
+			span.y = oy + gy;
+			span.x1 = ox + gx;
+			while (gx + 1 < gw && row[gx + 1]) gx++;
+			span.x2 = ox + gx;
+			spans.push_back(span);
 		}
 	}
 }
 
+void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+{
+	std::vector<FogSpan> spans;
+	TraceVisibility(Pos, range, los, spans);
+	ExploreSpans(spans);
+}
+
 void Map::UpdateFog()
 {
 	if (!(core->FogOfWar&FOG_DRAWFOG) ) {
@@ -3414,6 +3653,7 @@ void Map::UpdateFog()
 		SetMapVisibility( 0 );
 	}
 
+	FogPass++;
 	for (unsigned int e = 0; e<actors.size(); e++) {
 		Actor *actor = actors[e];
 		if (!actor->Modified[ IE_EXPLORE ] ) continue;
@@ -3422,13 +3662,33 @@ void Map::UpdateFog()
 			if (state & STATE_CANTSEE) continue;
 			int vis2 = actor->Modified[IE_VISUALRANGE];
 			if ((state&STATE_BLIND) || (vis2<2)) vis2=2; //can see only themselves
-			ExploreMapChunk (actor->Pos, vis2+actor->GetAnims()->GetCircleSize(), 1);
+			int range = vis2+actor->GetAnims()->GetCircleSize();
+			//the rays only need to be cast again if something changed
+			FogFootprint &fp = FogCache[actor->GetGlobalID()];
+			if (fp.pos != actor->Pos || fp.range != range || fp.generation != FogGeneration) {
+				TraceVisibility(actor->Pos, range, 1, fp.spans);
+				fp.pos = actor->Pos;
+				fp.range = range;
+				fp.generation = FogGeneration;
+			}
+			fp.pass = FogPass;
+			ExploreSpans(fp.spans);
 		}
 		Spawn *sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
 		if (sp) {
 			TriggerSpawn(sp);
 		}
 	}
+
+	//forget the footprints of actors that left or stopped exploring
+	std::map<ieDword, FogFootprint>::iterator it = FogCache.begin();
+	while (it != FogCache.end()) {
+		if (it->second.pass != FogPass) {
+			FogCache.erase(it++);
+		} else {
+			++it;
+		}
+	}
 }
 
 //Valid values are - PATH_MAP_FREE, PATH_MAP_PC, PATH_MAP_NPC
@@ -4071,7 +4331,15 @@ void Map::SetInternalSearchMap(int x, int y, int value)
 	if ((unsigned)x >= Width || (unsigned)y >= Height) {
 		return;
 	}
+	//actors are not part of the region graph, only terrain and doors
+	if ((SrchMap[x+y*Width] ^ value) & PATH_MAP_NOTACTOR) {
+		Clusters->Invalidate(x, y);
+	}
+	if ((SrchMap[x+y*Width] ^ value) & (PATH_MAP_NO_SEE|PATH_MAP_SIDEWALL|PATH_MAP_DOOR_OPAQUE)) {
+		FogGeneration++;
+	}
 	SrchMap[x+y*Width] = value;
+	SetSightMap(x+y*Width, value);
 }
 
 void Map::SetBackground(const ieResRef &bgResRef, ieDword duration)
@@ -24,10 +24,13 @@
 #include "exports.h"
 #include "globals.h"
 
+#include "ActorIndex.h"
 #include "Interface.h"
+#include "PathFinder.h"
 #include "Scriptable/Scriptable.h"
 
 #include <algorithm>
+#include <map>
 #include <queue>
 
 namespace GemRB {
@@ -43,7 +46,7 @@ class Image;
 class IniSpawn;
 class Palette;
 class Particles;
-struct PathNode;
+class PathCache;
 class Projectile;
 class ScriptedAnimation;
 class SpriteCover;
@@ -311,17 +314,57 @@ public:
 	Sprite2D *Background;
 	ieDword BgDuration;
 	ieDword LastGoCloser;
+	//shared trigger results reused/evaluated by the scripts of this area
+	ieDword TriggerHits, TriggerMisses;
+	//trigger evaluations of the scripts run in the current tick
+	ieDword ScriptCost;
+	//set while the party is here, otherwise idle actors are slowed down
+	bool PartyPresent;
 
 private:
 	ieStrRef trackString;
 	int trackFlag;
 	ieWord trackDiff;
 	unsigned short* MapSet;
+	//MapSet entries are only valid if their stamp matches the current search
+	ieDword* MapSetStamp;
+	ieDword MapSetGeneration;
 	unsigned short* SrchMap; //internal searchmap
+	//one bit per searchmap cell that blocks line of sight
+	ieDword* SightMap;
+	//direct mapped line of sight results, entries of older generations are stale
+	struct LOSCacheEntry {
+		ieDword from, to;
+		ieDword generation;
+		bool visible;
+	};
+	LOSCacheEntry* LOSCache;
+	ieDword LOSGeneration;
+	//fog tiles seen by an exploring actor, as runs of columns per tile row
+	struct FogSpan {
+		int y, x1, x2;
+	};
+	struct FogFootprint {
+		Point pos;
+		int range;
+		ieDword generation;
+		ieDword pass;
+		std::vector<FogSpan> spans;
+		FogFootprint() : range(-1), generation(0), pass(0) {}
+	};
+	//footprints of the explorers by global id, reused while they stand still
+	std::map<ieDword, FogFootprint> FogCache;
+	ieDword FogGeneration; //bumped when a door changes what blocks sight
+	ieDword FogPass;
+	std::vector<ieByte> FogScratch;
+	PathCache* Clusters; //region graph of SrchMap for long searches
+	bool CorridorSearch; //limit the search to the current corridor
 	std::queue< unsigned int> InternalStack;
+	std::vector< PathOpenNode> OpenList;
 	unsigned int Width, Height;
 	std::list< AreaAnimation*> animations;
 	std::vector< Actor*> actors;
+	ActorIndex ActorLookup; //grid and hashes over actors
 	Wall_Polygon **Walls;
 	unsigned int WallCount;
 	std::list< VEFObject*> vvcCells;
@@ -413,6 +456,12 @@ public:
 	Actor* GetActorByResource(const char* resref);
 	Actor* GetActorByScriptName(const char* name);
 	bool HasActor(Actor *actor);
+	/** refiles the actor in the position grid, call it after it moved or resized */
+	void UpdateActorIndex(Actor *actor);
+	/** refiles the actor under its new script name */
+	void UpdateActorName(Actor *actor);
+	/** returns the actors standing in the region, in the order of a backward walk of the actor list */
+	void GetActorsInRegion(const Region &rgn, std::vector<Actor*> &result) const;
 	bool SpawnsAlive() const;
 	void RemoveActor(Actor* actor);
 	//returns actors in rect (onlyparty could be more sophisticated)
@@ -568,6 +617,18 @@ private:
 	void Leveldown(unsigned int px, unsigned int py, unsigned int& level,
 		Point &p, unsigned int& diff);
 	void SetupNode(unsigned int x, unsigned int y, unsigned int size, unsigned int Cost);
+	void ResetMapSet();
+	inline unsigned int GetMapSet(unsigned int pos) const;
+	inline void SetMapSet(unsigned int pos, unsigned int value);
+	void OpenNode(unsigned int x, unsigned int y, unsigned int size, unsigned int Cost, const Point &target);
+	bool SearchPath(const Point &from, const Point &to, unsigned int size);
+	bool SearchPathNear(const Point &start, Point &goal, const Point &d, unsigned int size, unsigned int MinDistance, bool sight);
+	bool UseCorridor(const Point &start, const Point &goal);
+	inline bool BlocksSight(int x, int y) const;
+	void SetSightMap(unsigned int pos, unsigned int value);
+	bool TraceLOS(int sX, int sY, int dX, int dY) const;
+	void TraceVisibility(const Point &Pos, int range, int los, std::vector<FogSpan> &spans);
+	void ExploreSpans(const std::vector<FogSpan> &spans);
 	//actor uses travel region
 	void UseExit(Actor *pc, InfoPoint *ip);
 	//separated position adjustment, so their order could be randomised */
@@ -29,11 +29,22 @@
 
 #include "Plugin.h"
 
+#include "SClassID.h"
+#include "ie_types.h"
+
+#include <vector>
+
 namespace GemRB {
 
 class DataStream;
 class Map;
 
+/** a resource read while loading an area */
+struct AreaResource {
+	ieResRef ResRef;
+	SClass_ID Type;
+};
+
 /**
  * @class MapMgr
  * Abstract loader for Map objects
@@ -46,6 +57,8 @@ public:
 	virtual bool Open(DataStream* stream) = 0;
 	virtual bool ChangeMap(Map *map, bool day_or_night) = 0;
 	virtual Map* GetMap(const char* ResRef, bool day_or_night) = 0;
+	/** lists the external resources GetMap will need, without loading them */
+	virtual void GetResources(std::vector<AreaResource> &resources) = 0;
 
 	virtual int GetStoredFileSize(Map *map) = 0;
 	virtual int PutArea(DataStream* stream, Map *map) = 0;
@@ -0,0 +1,378 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "PathCache.h"
+
+#include "PathFinder.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+namespace GemRB {
+
+//cached routes are dropped wholesale past this
+#define MAX_CACHED_ROUTES 64
+
+//region ids pack the cluster index and the region number within it
+#define REGION_ID(cluster, region) (((cluster) << 8) | (region))
+#define REGION_CLUSTER(id) ((id) >> 8)
+#define REGION_INDEX(id) ((id) & 0xff)
+
+static unsigned int ChebyshevCost(const Point &a, const Point &b)
+{
+	unsigned int dx = (unsigned int) abs(a.x - b.x);
+	unsigned int dy = (unsigned int) abs(a.y - b.y);
+	return (dx > dy ? dx : dy) + 1;
+}
+
+PathCache::PathCache(const unsigned short *srchmap, unsigned int width, unsigned int height)
+{
+	SrchMap = srchmap;
+	Width = width;
+	Height = height;
+	Cols = (Width + PATH_CLUSTER_SIZE - 1) / PATH_CLUSTER_SIZE;
+	Rows = (Height + PATH_CLUSTER_SIZE - 1) / PATH_CLUSTER_SIZE;
+	Clusters = new Cluster[Cols * Rows];
+	for (unsigned int i = 0; i < Cols * Rows; i++) {
+		Clusters[i].relabel = true;
+		Clusters[i].relink = true;
+		Clusters[i].regions = 0;
+	}
+	Labels = (unsigned char *) calloc(Width * Height, sizeof(unsigned char));
+	CorridorMark = (ieDword *) calloc(Cols * Rows, sizeof(ieDword));
+	CorridorGeneration = 1;
+}
+
+PathCache::~PathCache()
+{
+	delete[] Clusters;
+	free(Labels);
+	free(CorridorMark);
+}
+
+//same as Map::GetBlocked, but without the actor bits
+bool PathCache::IsPassable(unsigned int x, unsigned int y) const
+{
+	unsigned int value = SrchMap[y * Width + x];
+	if (value & PATH_MAP_DOOR) {
+		return false;
+	}
+	return (value & PATH_MAP_PASSABLE) != 0;
+}
+
+void PathCache::Invalidate(unsigned int x, unsigned int y)
+{
+	if (x >= Width || y >= Height) {
+		return;
+	}
+	unsigned int cluster = (y / PATH_CLUSTER_SIZE) * Cols + x / PATH_CLUSTER_SIZE;
+	Clusters[cluster].relabel = true;
+	//the neighbours link to region ids that may not survive the relabel,
+	//so they have to be relinked before the next search walks them
+	for (int j = -1; j <= 1; j++) {
+		for (int i = -1; i <= 1; i++) {
+			unsigned int cx = cluster % Cols + i;
+			unsigned int cy = cluster / Cols + j;
+			if (cx < Cols && cy < Rows) {
+				Clusters[cy * Cols + cx].relink = true;
+			}
+		}
+	}
+	Routes.clear();
+}
+
+bool PathCache::IsDistant(const Point &start, const Point &goal) const
+{
+	int dx = abs(start.x - goal.x) / PATH_CLUSTER_SIZE;
+	int dy = abs(start.y - goal.y) / PATH_CLUSTER_SIZE;
+	return dx > 1 || dy > 1;
+}
+
+void PathCache::LabelCluster(unsigned int cluster)
+{
+	Cluster &c = Clusters[cluster];
+	unsigned int x0 = (cluster % Cols) * PATH_CLUSTER_SIZE;
+	unsigned int y0 = (cluster / Cols) * PATH_CLUSTER_SIZE;
+	unsigned int x1 = x0 + PATH_CLUSTER_SIZE;
+	unsigned int y1 = y0 + PATH_CLUSTER_SIZE;
+	if (x1 > Width) x1 = Width;
+	if (y1 > Height) y1 = Height;
+
+	unsigned int x, y;
+	for (y = y0; y < y1; y++) {
+		memset(Labels + y * Width + x0, 0, x1 - x0);
+	}
+
+	c.regions = 0;
+	c.centers.clear();
+	std::vector<unsigned int> stack;
+	for (y = y0; y < y1; y++) {
+		for (x = x0; x < x1; x++) {
+			if (Labels[y * Width + x] || !IsPassable(x, y)) {
+				continue;
+			}
+			//more regions than this means a checkerboard, merge the rest
+			if (c.regions < 255) {
+				c.regions++;
+			}
+			unsigned char region = c.regions;
+			unsigned long sumx = 0, sumy = 0, count = 0;
+			Labels[y * Width + x] = region;
+			stack.push_back((x << 16) | y);
+			while (stack.size()) {
+				unsigned int pos = stack.back();
+				stack.pop_back();
+				unsigned int px = pos >> 16;
+				unsigned int py = pos & 0xffff;
+				sumx += px;
+				sumy += py;
+				count++;
+				for (int j = -1; j <= 1; j++) {
+					for (int i = -1; i <= 1; i++) {
+						unsigned int nx = px + i;
+						unsigned int ny = py + j;
+						if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1) {
+							continue;
+						}
+						if (Labels[ny * Width + nx] || !IsPassable(nx, ny)) {
+							continue;
+						}
+						Labels[ny * Width + nx] = region;
+						stack.push_back((nx << 16) | ny);
+					}
+				}
+			}
+			if (c.centers.size() < region) {
+				c.centers.push_back(Point((short) (sumx / count), (short) (sumy / count)));
+			}
+		}
+	}
+	c.relabel = false;
+
+	//the links of this cluster and its neighbours point to the old regions
+	for (int j = -1; j <= 1; j++) {
+		for (int i = -1; i <= 1; i++) {
+			unsigned int cx = cluster % Cols + i;
+			unsigned int cy = cluster / Cols + j;
+			if (cx < Cols && cy < Rows) {
+				Clusters[cy * Cols + cx].relink = true;
+			}
+		}
+	}
+}
+
+void PathCache::LinkCluster(unsigned int cluster)
+{
+	Cluster &c = Clusters[cluster];
+	unsigned int x0 = (cluster % Cols) * PATH_CLUSTER_SIZE;
+	unsigned int y0 = (cluster / Cols) * PATH_CLUSTER_SIZE;
+	unsigned int x1 = x0 + PATH_CLUSTER_SIZE;
+	unsigned int y1 = y0 + PATH_CLUSTER_SIZE;
+	if (x1 > Width) x1 = Width;
+	if (y1 > Height) y1 = Height;
+
+	c.links.clear();
+	for (unsigned int y = y0; y < y1; y++) {
+		for (unsigned int x = x0; x < x1; x++) {
+			//only the border cells can touch other clusters
+			if (x != x0 && x != x1 - 1 && y != y0 && y != y1 - 1) {
+				continue;
+			}
+			unsigned char region = Labels[y * Width + x];
+			if (!region) {
+				continue;
+			}
+			for (int j = -1; j <= 1; j++) {
+				for (int i = -1; i <= 1; i++) {
+					unsigned int nx = x + i;
+					unsigned int ny = y + j;
+					if (nx >= Width || ny >= Height) {
+						continue;
+					}
+					if (nx >= x0 && nx < x1 && ny >= y0 && ny < y1) {
+						continue;
+					}
+					unsigned char other = Labels[ny * Width + nx];
+					if (!other) {
+						continue;
+					}
+					unsigned int neighbour = (ny / PATH_CLUSTER_SIZE) * Cols + nx / PATH_CLUSTER_SIZE;
+					RegionLink link;
+					link.region = region;
+					link.target = REGION_ID(neighbour, other);
+					size_t k;
+					for (k = 0; k < c.links.size(); k++) {
+						if (c.links[k].region == link.region && c.links[k].target == link.target) {
+							break;
+						}
+					}
+					if (k == c.links.size()) {
+						c.links.push_back(link);
+					}
+				}
+			}
+		}
+	}
+	c.relink = false;
+}
+
+void PathCache::Refresh(unsigned int cluster)
+{
+	if (Clusters[cluster].relabel) {
+		LabelCluster(cluster);
+	}
+	if (!Clusters[cluster].relink) {
+		return;
+	}
+	//linking reads the labels on both sides of the border
+	for (int j = -1; j <= 1; j++) {
+		for (int i = -1; i <= 1; i++) {
+			unsigned int cx = cluster % Cols + i;
+			unsigned int cy = cluster / Cols + j;
+			if (cx < Cols && cy < Rows && Clusters[cy * Cols + cx].relabel) {
+				LabelCluster(cy * Cols + cx);
+			}
+		}
+	}
+	LinkCluster(cluster);
+}
+
+unsigned int PathCache::GetRegion(const Point &p)
+{
+	if ((unsigned int) p.x >= Width || (unsigned int) p.y >= Height) {
+		return 0;
+	}
+	unsigned int cluster = (p.y / PATH_CLUSTER_SIZE) * Cols + p.x / PATH_CLUSTER_SIZE;
+	if (Clusters[cluster].relabel) {
+		LabelCluster(cluster);
+	}
+	unsigned char region = Labels[p.y * Width + p.x];
+	if (!region) {
+		return 0;
+	}
+	return REGION_ID(cluster, region);
+}
+
+//plain A* over the region graph, it is tiny compared to the searchmap
+bool PathCache::SearchRoute(unsigned int from, unsigned int to, std::vector<unsigned int> &route)
+{
+	typedef std::pair<unsigned int, unsigned int> OpenEntry;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry> > open;
+	std::map<unsigned int, unsigned int> cost;
+	std::map<unsigned int, unsigned int> parent;
+
+	const Point &goal = Clusters[REGION_CLUSTER(to)].centers[REGION_INDEX(to) - 1];
+	cost[from] = 0;
+	open.push(OpenEntry(0, from));
+	while (open.size()) {
+		unsigned int id = open.top().second;
+		unsigned int total = open.top().first;
+		open.pop();
+		if (id == to) {
+			route.clear();
+			while (true) {
+				route.push_back(REGION_CLUSTER(id));
+				if (id == from) break;
+				id = parent[id];
+			}
+			return true;
+		}
+		unsigned int cluster = REGION_CLUSTER(id);
+		unsigned char region = REGION_INDEX(id);
+		Refresh(cluster);
+		const Point &here = Clusters[cluster].centers[region - 1];
+		unsigned int sofar = cost[id];
+		if (total > sofar + ChebyshevCost(here, goal)) {
+			//superseded entry
+			continue;
+		}
+		const std::vector<RegionLink> &links = Clusters[cluster].links;
+		for (size_t i = 0; i < links.size(); i++) {
+			if (links[i].region != region) {
+				continue;
+			}
+			unsigned int next = links[i].target;
+			unsigned int nextCluster = REGION_CLUSTER(next);
+			if (Clusters[nextCluster].relabel) {
+				LabelCluster(nextCluster);
+			}
+			const Point &there = Clusters[nextCluster].centers[REGION_INDEX(next) - 1];
+			unsigned int nextCost = sofar + ChebyshevCost(here, there);
+			std::map<unsigned int, unsigned int>::iterator it = cost.find(next);
+			if (it != cost.end() && it->second <= nextCost) {
+				continue;
+			}
+			cost[next] = nextCost;
+			parent[next] = id;
+			open.push(OpenEntry(nextCost + ChebyshevCost(there, goal), next));
+		}
+	}
+	return false;
+}
+
+void PathCache::MarkRoute(const std::vector<unsigned int> &route)
+{
+	CorridorGeneration++;
+	if (!CorridorGeneration) {
+		memset(CorridorMark, 0, Cols * Rows * sizeof(ieDword));
+		CorridorGeneration = 1;
+	}
+	//the neighbouring clusters leave room to go around actors and corners
+	for (size_t k = 0; k < route.size(); k++) {
+		for (int j = -1; j <= 1; j++) {
+			for (int i = -1; i <= 1; i++) {
+				unsigned int cx = route[k] % Cols + i;
+				unsigned int cy = route[k] / Cols + j;
+				if (cx < Cols && cy < Rows) {
+					CorridorMark[cy * Cols + cx] = CorridorGeneration;
+				}
+			}
+		}
+	}
+}
+
+bool PathCache::FindCorridor(const Point &start, const Point &goal)
+{
+	unsigned int from = GetRegion(start);
+	unsigned int to = GetRegion(goal);
+	if (!from || !to) {
+		return false;
+	}
+
+	RouteKey key(from, to);
+	std::map<RouteKey, std::vector<unsigned int> >::iterator it = Routes.find(key);
+	if (it == Routes.end()) {
+		if (Routes.size() >= MAX_CACHED_ROUTES) {
+			Routes.clear();
+		}
+		std::vector<unsigned int> route;
+		SearchRoute(from, to, route);
+		it = Routes.insert(std::make_pair(key, route)).first;
+	}
+	if (it->second.empty()) {
+		return false;
+	}
+	MarkRoute(it->second);
+	return true;
+}
+
+}
@@ -0,0 +1,101 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include "exports.h"
+
+#include "Region.h"
+
+#include <map>
+#include <vector>
+
+namespace GemRB {
+
+//size of a cluster side, in searchmap cells
+#define PATH_CLUSTER_SIZE 16
+
+/**
+ * @class PathCache
+ * Coarse region graph of a searchmap, used to narrow down long searches.
+ * The searchmap is split into square clusters; each cluster is split into
+ * its connected passable regions and regions touching across a cluster
+ * border are linked. Only static terrain and doors are considered, moving
+ * actors are left to the fine search. Clusters are relabeled lazily after
+ * they were invalidated, so door changes only cost a local rebuild.
+ */
+
+class GEM_EXPORT PathCache {
+public:
+	PathCache(const unsigned short *srchmap, unsigned int width, unsigned int height);
+	~PathCache();
+
+	/** marks the cluster containing the searchmap cell as outdated */
+	void Invalidate(unsigned int x, unsigned int y);
+	/** true if the cells are far enough apart for a corridor to pay off */
+	bool IsDistant(const Point &start, const Point &goal) const;
+	/** marks the clusters along the coarse route from start to goal,
+	 * returns false if the regions are not connected */
+	bool FindCorridor(const Point &start, const Point &goal);
+	/** true if the searchmap cell is within the last corridor */
+	bool InCorridor(unsigned int x, unsigned int y) const
+	{
+		unsigned int cluster = (y / PATH_CLUSTER_SIZE) * Cols + x / PATH_CLUSTER_SIZE;
+		return CorridorMark[cluster] == CorridorGeneration;
+	}
+
+private:
+	struct RegionLink {
+		unsigned char region;
+		unsigned int target; //region id on the other side
+	};
+	struct Cluster {
+		bool relabel;
+		bool relink;
+		unsigned char regions;
+		std::vector<Point> centers;
+		std::vector<RegionLink> links;
+	};
+	typedef std::pair<unsigned int, unsigned int> RouteKey;
+
+	const unsigned short *SrchMap;
+	unsigned int Width, Height;
+	unsigned int Cols, Rows;
+	Cluster *Clusters;
+	//region of each searchmap cell within its cluster, 0 means impassable
+	unsigned char *Labels;
+	ieDword *CorridorMark;
+	ieDword CorridorGeneration;
+	//routes shared by actors travelling between the same regions
+	std::map<RouteKey, std::vector<unsigned int> > Routes;
+
+	bool IsPassable(unsigned int x, unsigned int y) const;
+	void Refresh(unsigned int cluster);
+	void LabelCluster(unsigned int cluster);
+	void LinkCluster(unsigned int cluster);
+	unsigned int GetRegion(const Point &p);
+	bool SearchRoute(unsigned int from, unsigned int to, std::vector<unsigned int> &route);
+	void MarkRoute(const std::vector<unsigned int> &route);
+};
+
+}
+
+#endif
@@ -51,6 +51,21 @@ struct PathNode {
 	unsigned int orient;
 };
 
+//an entry of the A* open list, ordered so std::*_heap yields the lowest
+//estimated total cost first (ties prefer the node closer to the target)
+struct PathOpenNode {
+	unsigned int total; //cost so far plus heuristic estimate
+	unsigned int cost; //cost so far, used to detect superseded entries
+	unsigned int pos; //searchmap coordinates packed as (x << 16) | y
+
+	bool operator<(const PathOpenNode &other) const {
+		if (total != other.total) {
+			return total > other.total;
+		}
+		return cost < other.cost;
+	}
+};
+
 }
 
 #endif
@@ -25,8 +25,11 @@
 #include "Resource.h"
 #include "ResourceDesc.h"
 #include "ResourceSource.h"
+#include "System/DataStream.h"
 #include "System/StringBuffer.h"
 
+#include <cctype>
+
 namespace GemRB {
 
 ResourceManager::ResourceManager()
@@ -36,6 +39,7 @@ ResourceManager::ResourceManager()
 
 ResourceManager::~ResourceManager()
 {
+	ClearPrefetched();
 }
 
 bool ResourceManager::AddSource(const char *path, const char *description, PluginID type, int flags)
@@ -107,12 +111,62 @@ bool ResourceManager::Exists(const char *ResRef, const TypeID *type, bool silent
 	return false;
 }
 
+static std::pair<std::string, SClass_ID> PrefetchKey(const char* ResRef, SClass_ID type)
+{
+	std::string key;
+	for (int i = 0; i < 8 && ResRef[i]; i++) {
+		key += (char) tolower(ResRef[i]);
+	}
+	return std::make_pair(key, type);
+}
+
+void ResourceManager::AddPrefetched(const char* ResRef, SClass_ID type, DataStream *stream)
+{
+	DataStream *&slot = prefetched[PrefetchKey(ResRef, type)];
+	delete slot;
+	slot = stream;
+}
+
+void ResourceManager::ClearPrefetched()
+{
+	for (PrefetchMap::iterator it = prefetched.begin(); it != prefetched.end(); ++it) {
+		delete it->second;
+	}
+	prefetched.clear();
+}
+
+// the streams were read from the search path with the same lookup order,
+// so handing them out here doesn't change which file wins
+DataStream* ResourceManager::TakePrefetched(const char* ResRef, SClass_ID type) const
+{
+	if (prefetched.empty()) {
+		return NULL;
+	}
+	PrefetchMap::iterator it = prefetched.find(PrefetchKey(ResRef, type));
+	if (it == prefetched.end()) {
+		return NULL;
+	}
+	DataStream *ds = it->second;
+	prefetched.erase(it);
+	return ds;
+}
+
 DataStream* ResourceManager::GetResource(const char* ResRef, SClass_ID type, bool silent) const
 {
 	if (ResRef[0] == '\0')
 		return NULL;
+	DataStream *ds = TakePrefetched(ResRef, type);
+	if (ds) {
+		if (!silent) {
+			Log(MESSAGE, "ResourceManager", "Found '%s.%s' read ahead.",
+				ResRef, core->TypeExt(type));
+		}
+		return ds;
+	}
 	for (size_t i = 0; i < searchPath.size(); i++) {
+		ieQword profile = core->ProfileStart();
 		DataStream *ds = searchPath[i]->GetResource(ResRef, type);
+		core->ProfileEnd(PROFILE_RESOURCES, profile);
 		if (ds) {
 			if (!silent) {
 				Log(MESSAGE, "ResourceManager", "Found '%s.%s' in '%s'.",
@@ -137,8 +191,24 @@ Resource* ResourceManager::GetResource(const char* ResRef, const TypeID *type, b
 	}
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (size_t j = 0; j < types.size(); j++) {
+		DataStream *str = NULL;
+		if (types[j].GetKeyType()) {
+			str = TakePrefetched(ResRef, types[j].GetKeyType());
+		}
+		if (str) {
+			Resource *res = types[j].Create(str);
+			if (res) {
+				if (!silent) {
+					Log(MESSAGE, "ResourceManager", "Found '%s.%s' read ahead.",
+						ResRef, types[j].GetExt());
+				}
+				return res;
+			}
+		}
 		for (size_t i = 0; i < searchPath.size(); i++) {
-			DataStream *str = searchPath[i]->GetResource(ResRef, types[j]);
+			ieQword profile = core->ProfileStart();
+			str = searchPath[i]->GetResource(ResRef, types[j]);
+			core->ProfileEnd(PROFILE_RESOURCES, profile);
 			if (str) {
 				Resource *res = types[j].Create(str);
 				if (res) {
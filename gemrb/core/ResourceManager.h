@@ -26,6 +26,8 @@
 
 #include "Holder.h"
 
+#include <map>
+#include <string>
 #include <vector>
 
 #ifdef _MSC_VER // No SFINAE
@@ -65,8 +67,18 @@ public:
 	/** Returns Resource object associated to given resource */
 	Resource* GetResource(const char* resname, const TypeID *type, bool silent = false) const;
 
+	/** Keeps a resource that was read ahead, the next lookup of it takes over the stream */
+	void AddPrefetched(const char* resname, SClass_ID type, DataStream *stream);
+	/** Frees the resources read ahead that were never asked for */
+	void ClearPrefetched();
+
 private:
+	typedef std::map<std::pair<std::string, SClass_ID>, DataStream*> PrefetchMap;
+
 	std::vector<Holder<ResourceSource> > searchPath;
+	mutable PrefetchMap prefetched;
+
+	DataStream* TakePrefetched(const char* resname, SClass_ID type) const;
 };
 
 }
@@ -434,6 +434,8 @@ Actor::Actor()
 		Modified[i] = 0;
 	}
 	PrevStats = NULL;
+	StaticStats = NULL;
+	StaticSignature = 0;
 
 	SmallPortrait[0] = 0;
 	LargePortrait[0] = 0;
@@ -542,6 +544,7 @@ Actor::~Actor(void)
 	core->FreeString( ShortName );
 
 	delete PCStats;
+	free(StaticStats);
 
 	for (i = 0; i < vvcOverlays.size(); i++) {
 		if (vvcOverlays[i]) {
@@ -760,6 +763,9 @@ void Actor::SetCircleSize()
 		csize = MAX_CIRCLE_SIZE - 1;
 
 	SetCircle( anims->GetCircleSize(), *color, core->GroundCircles[csize][color_index], core->GroundCircles[csize][(color_index == 0) ? 3 : color_index] );
+	if (area) {
+		area->UpdateActorIndex(this);
+	}
 }
 
 static void ApplyClab_internal(Actor *actor, const char *clab, int level, bool remove)
@@ -3053,11 +3059,12 @@ void Actor::RefreshEffects(EffectQueue *fx)
 	//move this further down if needed
 	PrevStats = NULL;
 
-	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
-		m->flags |= TEF_PROCESSED_EFFECTS;
+	//by index, the charm handling may add triggers
+	for (size_t i = 0; i < triggers.size(); i++) {
+		triggers[i].flags |= TEF_PROCESSED_EFFECTS;
 
 		// snap out of charm if the charmer hurt us
-		if (m->triggerID == trigger_attackedby) {
+		if (triggers[i].triggerID == trigger_attackedby) {
 			Actor *attacker = core->GetGame()->GetActorByGlobalID(LastAttacker);
 			if (attacker) {
 				int revertToEA = 0;
@@ -3147,6 +3154,93 @@ void Actor::RefreshEffects(EffectQueue *fx)
 	}
 }
 
+//a full refresh gives the same stats again if only static effects are in
+//the queue and the class based stats can't change on this tick
+bool Actor::HasStaticEffects(ieDword &signature) const
+{
+	if (PCStats || InParty || pstflags || !triggers.empty() || Modified[IE_PUPPETID]) {
+		return false;
+	}
+	if (!fxqueue.GetStaticSignature(signature)) {
+		return false;
+	}
+	// IE_CLASS is >classcount for non-PCs/NPCs, those have no class based pass
+	if (BaseStats[IE_CLASS] == 0 || BaseStats[IE_CLASS] >= (ieDword)classcount) {
+		return true;
+	}
+
+	//RefreshPCStats recovers morale and regenerates hit points on some ticks
+	ieDword gametime = core->GetGame()->GameTime;
+	int mrec = Modified[IE_MORALERECOVERYTIME];
+	if (mrec && !(gametime % mrec) && BaseStats[IE_MORALE] != 10) {
+		return false;
+	}
+	int rate = core->GetConstitutionBonus(STAT_CON_HP_REGEN, Modified[IE_CON]);
+	if (rate && !(gametime % (rate*AI_UPDATE_TIME))) {
+		return false;
+	}
+
+	//it also depends on the equipped weapon and the difficulty
+	signature = signature * 31 + inventory.GetEquipped();
+	signature = signature * 31 + inventory.GetEquippedHeader();
+	signature = signature * 31 + GameDifficulty;
+	int slots[2] = { inventory.GetEquippedSlot(), inventory.GetShieldSlot() };
+	for (int i = 0; i < 2; i++) {
+		const CREItem *item = slots[i] >= 0 ? inventory.GetSlotItem(slots[i]) : NULL;
+		if (!item) {
+			signature = signature * 31;
+			continue;
+		}
+		for (int j = 0; j < 8 && item->ItemResRef[j]; j++) {
+			signature = signature * 31 + (unsigned char) item->ItemResRef[j];
+		}
+	}
+	return true;
+}
+
+void Actor::UpdateEffects()
+{
+	ieDword signature = 0;
+
+	//skip if nothing touched the stats or the effects since the last refresh
+	if (StaticStats && HasStaticEffects(signature) && signature == StaticSignature
+		&& !memcmp(StaticStats, BaseStats, MAX_STATS * sizeof(ieDword))
+		&& !memcmp(StaticStats + MAX_STATS, Modified, MAX_STATS * sizeof(ieDword))) {
+		if (core->CheckStaticRefresh) {
+			//refresh anyway and report what the skip would have missed
+			RefreshEffects(NULL);
+			for (int i = 0; i < MAX_STATS; i++) {
+				if (StaticStats[i] != BaseStats[i] || StaticStats[MAX_STATS + i] != Modified[i]) {
+					Log(ERROR, "Actor", "Skipped refresh of %s would have changed stat %d: base %d->%d, modified %d->%d",
+						LongName, i, StaticStats[i], BaseStats[i], StaticStats[MAX_STATS + i], Modified[i]);
+				}
+			}
+			memcpy(StaticStats, BaseStats, MAX_STATS * sizeof(ieDword));
+			memcpy(StaticStats + MAX_STATS, Modified, MAX_STATS * sizeof(ieDword));
+			return;
+		}
+		//the parts of RefreshEffects that don't depend on the effects
+		CharAnimations* anims = GetAnims();
+		if (anims) {
+			anims->CheckColorMod();
+		}
+		if (Immobile()) {
+			timeStartStep = core->GetGame()->Ticks;
+		}
+		return;
+	}
+
+	RefreshEffects(NULL);
+	if (HasStaticEffects(signature)) {
+		if (!StaticStats) {
+			StaticStats = (ieDword *) malloc(2 * MAX_STATS * sizeof(ieDword));
+		}
+		memcpy(StaticStats, BaseStats, MAX_STATS * sizeof(ieDword));
+		memcpy(StaticStats + MAX_STATS, Modified, MAX_STATS * sizeof(ieDword));
+		StaticSignature = signature;
+	}
+}
+
 int Actor::GetProficiency(int proftype) const
 {
 	switch(proftype) {
@@ -4462,6 +4556,14 @@ void Actor::dump(StringBuffer& buffer) const
 		buffer.appendFormatted( " %.8s", poi );
 	}
 	buffer.append("\n");
+	buffer.appendFormatted("Script cost: %d\n", ScriptCost);
+	for (i = 0; i < MAX_SCRIPTS; i++) {
+		if (Scripts[i]) {
+			ieDword runs, cost;
+			Scripts[i]->GetCost(runs, cost);
+			buffer.appendFormatted("  %.8s: %d runs, %d triggers\n", Scripts[i]->GetName(), runs, cost);
+		}
+	}
 	buffer.appendFormatted("Area:       %.8s ([%d.%d])   ", Area, Pos.x, Pos.y);
 	buffer.appendFormatted("Dialog:     %.8s\n", Dialog );
 	buffer.appendFormatted("Global ID:  %d   PartySlot: %d\n", GetGlobalID(), InParty);
@@ -6002,7 +6104,11 @@ bool Actor::DoStep(unsigned int walk_speed, ieDword time)
 		return true;
 	}
 
-	return Movable::DoStep(walk_speed, time);
+	bool ret = Movable::DoStep(walk_speed, time);
+	if (area) {
+		area->UpdateActorIndex(this);
+	}
+	return ret;
 }
 
 ieDword Actor::GetNumberOfAttacks()
@@ -9587,6 +9693,11 @@ bool Actor::CannotPassEntrance(ieDword exitID) const
 void Actor::UseExit(ieDword exitID) {
 	if (exitID) {
 		InternalFlags|=IF_USEEXIT;
+		//start reading the destination while we walk to the exit
+		const InfoPoint *ip = area ? area->GetInfoPointByGlobalID(exitID) : NULL;
+		if (ip && ip->Destination[0]) {
+			core->GetGame()->Prefetch(ip->Destination);
+		}
 	} else {
 		InternalFlags&=~IF_USEEXIT;
 		memcpy(LastArea, Area, 8);
@@ -369,6 +369,9 @@ private:
 	/*The projectile bringing the current attack*/
 	Projectile* attackProjectile ;
 	int TicksLastRested;
+	//stats after the last full refresh, kept while only static effects apply
+	ieDword *StaticStats;
+	ieDword StaticSignature;
 	/** paint the actor itself. Called internally by Draw() */
 	void DrawActorSprite(const Region &screen, int cx, int cy, const Region& bbox,
 				SpriteCover*& sc, Animation** anims,
@@ -395,6 +398,7 @@ private:
 	/** Re/Inits the Modified vector for PCs/NPCs */
 	void RefreshPCStats();
 	void RefreshHP();
+	bool HasStaticEffects(ieDword &signature) const;
 	bool ShouldHibernate();
 	bool ShouldDrawCircle() const;
 	bool HasBodyHeat() const;
@@ -432,6 +436,8 @@ public:
 	void CheckPuppet(Actor *puppet, ieDword type);
 	/** Re/Inits the Modified vector */
 	void RefreshEffects(EffectQueue *eqfx);
+	/** RefreshEffects for every tick, skipped when it couldn't change anything */
+	void UpdateEffects();
 	/** gets saving throws */
 	void RollSaves();
 	/** returns a saving throw */
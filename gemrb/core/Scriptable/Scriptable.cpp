@@ -92,6 +92,8 @@ Scriptable::Scriptable(ScriptableType type)
 	IdleTicks = 0;
 	AuraTicks = 100;
 	TriggerCountdown = 0;
+	ScriptCost = 0;
+	ScriptDeferred = false;
 	Dialog[0] = 0;
 
 	globalID = ++globalActorCounter;
@@ -146,6 +148,9 @@ void Scriptable::SetScriptName(const char* text)
 	if (text) {
 		strnspccpy( scriptName, text, 32 );
 	}
+	if (Type == ST_ACTOR && area) {
+		area->UpdateActorName((Actor *) this);
+	}
 }
 
 /** Gets the DeathVariable */
@@ -324,11 +329,37 @@ void Scriptable::Update()
 	InterruptCasting = false;
 }
 
+//actors away from the party with nothing to do or react to
+bool Scriptable::IsScriptIdle() const
+{
+	if (Type != ST_ACTOR || ((Actor *) this)->InParty) {
+		return false;
+	}
+	if (CurrentAction || GetNextAction() || !triggers.empty() || TriggerCountdown) {
+		return false;
+	}
+	if (InternalFlags & IF_FORCEUPDATE) {
+		return false;
+	}
+	const Map *map = GetCurrentArea();
+	return map && !map->PartyPresent;
+}
+
 void Scriptable::TickScripting()
 {
-	// Stagger script updates.
-	if (Ticks % 16 != globalID % 16)
+	// Stagger script updates, idle actors get only every fourth round.
+	// Since the periods are multiples, their rounds stay in the same slots.
+	bool idle = IsScriptIdle();
+	ieDword period = idle ? SCRIPT_IDLE_PERIOD : SCRIPT_PERIOD;
+	if (!ScriptDeferred && Ticks % period != globalID % period)
+		return;
+
+	// Don't let a crowded background area spend it all in one tick.
+	if (idle && GetCurrentArea()->ScriptCost > SCRIPT_IDLE_BUDGET) {
+		ScriptDeferred = true;
 		return;
+	}
+	ScriptDeferred = false;
 
 	ieDword actorState = 0;
 	if (Type == ST_ACTOR)
@@ -501,12 +532,11 @@ Action* Scriptable::PopNextAction()
 void Scriptable::ClearActions()
 {
 	ReleaseCurrentAction();
-	for (unsigned int i = 0; i < actionQueue.size(); i++) {
+	while (!actionQueue.empty()) {
 		Action* aC = actionQueue.front();
 		actionQueue.pop_front();
 		aC->Release();
 	}
-	actionQueue.clear();
 	WaitCounter = 0;
 	LastTarget = 0;
 	LastTargetPos.empty();
@@ -678,7 +708,7 @@ void Scriptable::AddTrigger(TriggerEntry trigger)
 }
 
 bool Scriptable::MatchTrigger(unsigned short id, ieDword param) {
-	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
+	for (std::vector<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
 		TriggerEntry &trigger = *m;
 		if (trigger.triggerID != id)
 			continue;
@@ -691,7 +721,7 @@ bool Scriptable::MatchTrigger(unsigned short id, ieDword param) {
 }
 
 bool Scriptable::MatchTriggerWithObject(unsigned short id, class Object *obj, ieDword param) {
-	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
+	for (std::vector<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
 		TriggerEntry &trigger = *m;
 		if (trigger.triggerID != id)
 			continue;
@@ -706,7 +736,7 @@ bool Scriptable::MatchTriggerWithObject(unsigned short id, class Object *obj, ie
 }
 
 const TriggerEntry *Scriptable::GetMatchingTrigger(unsigned short id, unsigned int notflags) {
-	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
+	for (std::vector<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
 		TriggerEntry &trigger = *m;
 		if (trigger.triggerID != id)
 			continue;
@@ -2201,6 +2231,7 @@ void Movable::FixPosition()
 	GetCurrentArea()->AdjustPosition(Pos);
 	Pos.x=Pos.x*16+8;
 	Pos.y=Pos.y*12+6;
+	area->UpdateActorIndex(actor);
 }
 
 void Movable::WalkTo(const Point &Des, int distance)
@@ -2315,6 +2346,9 @@ void Movable::MoveTo(const Point &Des)
 	area->ClearSearchMapFor(this);
 	Pos = Des;
 	Destination = Des;
+	if (Type == ST_ACTOR) {
+		area->UpdateActorIndex((Actor *) this);
+	}
 	if (BlocksSearchMap()) {
 		area->BlockSearchMap( Pos, size, IsPC()?PATH_MAP_PC:PATH_MAP_NPC);
 	}
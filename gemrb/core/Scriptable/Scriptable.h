@@ -25,8 +25,10 @@
 
 #include "Variables.h"
 
+#include <deque>
 #include <list>
 #include <map>
+#include <vector>
 
 namespace GemRB {
 
@@ -62,6 +64,14 @@ class SpriteCover;
 #define SCR_GENERAL  6
 #define SCR_DEFAULT  7
 
+//script rounds are staggered over this many ticks
+#define SCRIPT_PERIOD      16
+//the same for idle actors in areas without the party
+#define SCRIPT_IDLE_PERIOD 64
+//trigger evaluations per tick an area may spend on idle actors,
+//the rest is carried over to the next tick
+#define SCRIPT_IDLE_BUDGET 2048
+
 //pst trap flags (portal)
 #define PORTAL_CURSOR 1
 #define PORTAL_TRAVEL 2
@@ -214,12 +224,12 @@ private:
 	std::map<ieDword,ieDword> script_timers;
 	ieDword globalID;
 protected: //let Actor access this
-	std::list<TriggerEntry> triggers;
+	std::vector<TriggerEntry> triggers;
 	Map *area;
 	ieVariable scriptName;
 	ieDword InternalFlags; //for triggers
 	ieResRef Dialog;
-	std::list< Action*> actionQueue;
+	std::deque< Action*> actionQueue;
 	Action* CurrentAction;
 
 	// Variables for overhead text.
@@ -246,6 +256,10 @@ public:
 	ieDword AuraTicks;
 	// The countdown for forced activation by triggers.
 	ieDword TriggerCountdown;
+	// The number of triggers evaluated by our scripts.
+	ieDword ScriptCost;
+	// Our script round was postponed by the idle budget.
+	bool ScriptDeferred;
 
 	Variables* locals;
 	ScriptableType Type;
@@ -321,6 +335,7 @@ public:
 	bool IsPC() const;
 	virtual void Update();
 	void TickScripting();
+	bool IsScriptIdle() const;
 	virtual void ExecuteScript(int scriptCount);
 	void AddAction(Action* aC);
 	void AddActionInFront(Action* aC);
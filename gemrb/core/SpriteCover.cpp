@@ -23,11 +23,12 @@
 #include "Interface.h"
 #include "Video.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 SpriteCover::SpriteCover()
 {
-	pixels = 0;
 	worldx = worldy = XPos = YPos = Width = Height = flags = 0;
 }
 
@@ -51,4 +52,93 @@ bool SpriteCover::Covers(int x, int y, int xpos, int ypos,
 	return true;
 }
 
+void SpriteCover::AddSpan(int y, int start, int end, bool dither)
+{
+	PendingSpan p;
+	p.y = y;
+	p.span.start = start;
+	p.span.end = end;
+	p.span.dither = dither;
+	pending.push_back(p);
+}
+
+void SpriteCover::Finish()
+{
+	std::sort(pending.begin(), pending.end());
+	spans.clear();
+	lines.assign(Height + 1, 0);
+
+	std::vector<int> edges;
+	size_t i = 0;
+	for (int y = 0; y < Height; y++) {
+		lines[y] = (int) spans.size();
+		size_t first = i;
+		while (i < pending.size() && pending[i].y == y) i++;
+		if (first == i) continue;
+
+		// cut the line at every span edge, each piece is covered fully
+		// if any full span contains it, otherwise dithered if any does
+		edges.clear();
+		for (size_t j = first; j < i; j++) {
+			edges.push_back(pending[j].span.start);
+			edges.push_back(pending[j].span.end);
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+		for (size_t e = 0; e + 1 < edges.size(); e++) {
+			int from = edges[e];
+			int to = edges[e + 1];
+			int state = 0; // 0 - open, 1 - dithered, 2 - full
+			for (size_t j = first; j < i && state < 2; j++) {
+				const CoverSpan& s = pending[j].span;
+				if (s.start <= from && s.end >= to) {
+					state = s.dither ? 1 : 2;
+				}
+			}
+			if (!state) continue;
+
+			bool dither = state == 1;
+			if (spans.size() > (size_t) lines[y] && spans.back().end == from && spans.back().dither == dither) {
+				spans.back().end = to;
+			} else {
+				CoverSpan span = { from, to, dither };
+				spans.push_back(span);
+			}
+		}
+	}
+	lines[Height] = (int) spans.size();
+	pending.clear();
+}
+
+void SpriteCover::Clear()
+{
+	pending.clear();
+	spans.clear();
+	lines.clear();
+}
+
+const CoverSpan* SpriteCover::GetLine(int y, int& count) const
+{
+	if (y < 0 || y >= Height || lines.empty()) {
+		count = 0;
+		return NULL;
+	}
+	count = lines[y + 1] - lines[y];
+	return count ? &spans[lines[y]] : NULL;
+}
+
+bool SpriteCover::IsCovered(int x, int y) const
+{
+	int count;
+	const CoverSpan* line = GetLine(y, count);
+	for (int i = 0; i < count; i++) {
+		if (x < line[i].start) break;
+		if (x < line[i].end) {
+			return !line[i].dither || DitherCovers(x, y);
+		}
+	}
+	return false;
+}
+
 }
@@ -23,11 +23,18 @@
 
 #include "exports.h"
 
+#include <vector>
+
 namespace GemRB {
 
+//a run of covered pixels on one line, dithered spans only cover every other pixel
+struct CoverSpan {
+	int start, end;
+	bool dither;
+};
+
 class GEM_EXPORT SpriteCover {
 public:
-	unsigned char* pixels;
 	int worldx, worldy; // world coords for which the cover has been computed
 	int XPos, YPos, Width, Height;
 	int flags;
@@ -35,8 +42,82 @@ public:
 	~SpriteCover(void);
 
 	bool Covers(int x, int y, int xpos, int ypos, int width, int height) const;
+
+	/** covers [start, end) of a line, call Finish after the last span */
+	void AddSpan(int y, int start, int end, bool dither);
+	/** sorts and merges the added spans into disjoint ones per line */
+	void Finish();
+	/** removes all spans */
+	void Clear();
+	/** the sorted, disjoint spans of line y */
+	const CoverSpan* GetLine(int y, int& count) const;
+	/** true if the dither pattern covers this pixel of a dithered span */
+	bool DitherCovers(int x, int y) const { return !((x + y + worldx - XPos + worldy - YPos) & 1); }
+	bool IsCovered(int x, int y) const;
+
+private:
+	struct PendingSpan {
+		int y;
+		CoverSpan span;
+		bool operator<(const PendingSpan& other) const
+		{
+			if (y != other.y) return y < other.y;
+			return span.start < other.span.start;
+		}
+	};
+	std::vector<PendingSpan> pending;
+	std::vector<CoverSpan> spans;
+	//index of the first span of each line, plus one past the last line
+	std::vector<int> lines;
 };
 
+/**
+ * Walks the spans of one cover line. Blitters query the pixels in drawing
+ * order, so the current span is remembered instead of searched each time.
+ */
+class CoverLine {
+public:
+	CoverLine() : spans(0), count(0), cur(0), cover(0), y(0) {}
+
+	void Start(const SpriteCover* sc, int line)
+	{
+		cover = sc;
+		y = line;
+		spans = sc->GetLine(line, count);
+		cur = 0;
+	}
+
+	bool Covered(int x)
+	{
+		if (!count) return false;
+		Seek(x);
+		const CoverSpan& s = spans[cur];
+		if (x < s.start || x >= s.end) return false;
+		return !s.dither || cover->DitherCovers(x, y);
+	}
+
+	/** number of fully covered pixels from x on, going in direction dir */
+	int CoveredRun(int x, int dir)
+	{
+		if (!count) return 0;
+		Seek(x);
+		const CoverSpan& s = spans[cur];
+		if (s.dither || x < s.start || x >= s.end) return 0;
+		return dir > 0 ? s.end - x : x - s.start + 1;
+	}
+
+private:
+	const CoverSpan* spans;
+	int count, cur;
+	const SpriteCover* cover;
+	int y;
+
+	void Seek(int x)
+	{
+		while (cur > 0 && spans[cur].start > x) cur--;
+		while (cur < count - 1 && spans[cur].end <= x) cur++;
+	}
+};
 
 }
 
@@ -0,0 +1,218 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "System/MappedStream.h"
+
+#include "win32def.h"
+
+#include "Interface.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GemRB {
+
+#ifdef WIN32
+struct MappedStream::Mapping {
+private:
+	HANDLE file, mapping;
+	int refcount;
+	void *view;
+public:
+	const char* data;
+
+	Mapping() : file(INVALID_HANDLE_VALUE), mapping(NULL), refcount(1), view(NULL), data(NULL) {}
+	bool Open(const char *name, unsigned long offset, unsigned long size) {
+		file = CreateFile(name,
+			GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE,
+			NULL,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		DWORD length = GetFileSize(file, NULL);
+		if (length == 0xFFFFFFFF || offset > length || size > length - offset) {
+			return false;
+		}
+		mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mapping) {
+			return false;
+		}
+		// views have to start on the allocation granularity
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		unsigned long start = offset - offset % info.dwAllocationGranularity;
+		view = MapViewOfFile(mapping, FILE_MAP_READ, 0, start, size + offset - start);
+		if (!view) {
+			return false;
+		}
+		data = (const char *) view + offset - start;
+		return true;
+	}
+	void Acquire() { refcount++; }
+	void Release() { if (!--refcount) delete this; }
+	~Mapping() {
+		if (view) UnmapViewOfFile(view);
+		if (mapping) CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+	}
+};
+#else
+struct MappedStream::Mapping {
+private:
+	int refcount;
+	void *view;
+	size_t length;
+public:
+	const char* data;
+
+	Mapping() : refcount(1), view(NULL), length(0), data(NULL) {}
+	bool Open(const char *name, unsigned long offset, unsigned long size) {
+		int fd = open(name, O_RDONLY);
+		if (fd == -1) {
+			return false;
+		}
+		// touching a mapping past the end of the file raises SIGBUS
+		struct stat st;
+		if (fstat(fd, &st) || (off_t) offset > st.st_size || (off_t) size > st.st_size - (off_t) offset) {
+			close(fd);
+			return false;
+		}
+		// mappings have to start on a page boundary
+		unsigned long page = (unsigned long) sysconf(_SC_PAGESIZE);
+		unsigned long start = offset - offset % page;
+		length = size + offset - start;
+		void *addr = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, (off_t) start);
+		// the mapping stays valid after the descriptor is closed
+		close(fd);
+		if (addr == MAP_FAILED) {
+			return false;
+		}
+		view = addr;
+		data = (const char *) addr + offset - start;
+		return true;
+	}
+	void Acquire() { refcount++; }
+	void Release() { if (!--refcount) delete this; }
+	~Mapping() {
+		if (view) munmap(view, length);
+	}
+};
+#endif
+
+MappedStream::MappedStream(Mapping* map, const char* data, unsigned long size)
+	: map(map), data(data)
+{
+	this->size = size;
+}
+
+MappedStream::~MappedStream(void)
+{
+	map->Release();
+}
+
+DataStream* MappedStream::Clone()
+{
+	return Slice(0, size);
+}
+
+DataStream* MappedStream::Slice(unsigned long startpos, unsigned long length)
+{
+	if (startpos + length > size) {
+		return NULL;
+	}
+	map->Acquire();
+	MappedStream *slice = new MappedStream(map, data + startpos, length);
+	strlcpy(slice->originalfile, originalfile, _MAX_PATH);
+	strlcpy(slice->filename, filename, sizeof(filename));
+	return slice;
+}
+
+int MappedStream::Read(void* dest, unsigned int length)
+{
+	//we don't allow partial reads anyway, so it isn't a problem that
+	//i don't adjust length here (partial reads are evil)
+	if (Pos+length>size ) {
+		return GEM_ERROR;
+	}
+
+	memcpy(dest, data + Pos + (Encrypted ? 2 : 0), length);
+	if (Encrypted) {
+		ReadDecrypted( dest, length );
+	}
+	Pos += length;
+	return length;
+}
+
+int MappedStream::Write(const void* /*src*/, unsigned int /*length*/)
+{
+	// the mapping is read-only
+	return GEM_ERROR;
+}
+
+int MappedStream::Seek(int newpos, int type)
+{
+	switch (type) {
+		case GEM_CURRENT_POS:
+			Pos += newpos;
+			break;
+
+		case GEM_STREAM_START:
+			Pos = newpos;
+			break;
+
+		case GEM_STREAM_END:
+			Pos = size - newpos;
+			break;
+
+		default:
+			return GEM_ERROR;
+	}
+	//we went past the buffer
+	if (Pos>size) {
+		print("[Streams]: Invalid seek position: %ld(limit: %ld)", Pos, size);
+		return GEM_ERROR;
+	}
+	return GEM_OK;
+}
+
+MappedStream* MappedStream::OpenFile(const char* filename, unsigned long offset, unsigned long size)
+{
+	if (!size) {
+		return NULL;
+	}
+	Mapping *map = new Mapping();
+	if (!map->Open(filename, offset, size)) {
+		map->Release();
+		return NULL;
+	}
+	MappedStream *ms = new MappedStream(map, map->data, size);
+	ExtractFileFromPath(ms->filename, filename);
+	strlcpy(ms->originalfile, filename, _MAX_PATH);
+	return ms;
+}
+
+}
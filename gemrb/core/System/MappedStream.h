@@ -0,0 +1,74 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+/**
+ * @file MappedStream.h
+ * Declares MappedStream class, stream reading data from a memory mapped file.
+ * @author The GemRB Project
+ */
+
+
+#ifndef MAPPEDSTREAM_H
+#define MAPPEDSTREAM_H
+
+#include "System/DataStream.h"
+
+#include "exports.h"
+#include "globals.h"
+
+namespace GemRB {
+
+/**
+ * @class MappedStream
+ * Reads data from a read-only memory mapping of a part of a file.
+ * Only the window of a single resource is mapped, so a 32-bit process
+ * doesn't run out of address space on big archives. Clones and slices
+ * share the mapping instead of reopening or copying the file; it is
+ * released with the last stream using it.
+ */
+
+class GEM_EXPORT MappedStream : public DataStream {
+private:
+	struct Mapping;
+	Mapping* map;
+	const char* data;
+
+	MappedStream(Mapping* map, const char* data, unsigned long size);
+public:
+	~MappedStream(void);
+	DataStream* Clone();
+
+	int Read(void* dest, unsigned int length);
+	int Write(const void* src, unsigned int length);
+	int Seek(int pos, int startpos);
+
+	/** Returns a stream over a part of this one, sharing the mapping. */
+	DataStream* Slice(unsigned long startpos, unsigned long size);
+public:
+	/** Maps size bytes of the specified file, starting at offset.
+	 *
+	 *  Returns NULL, if the file can't be opened or mapped, or is too short.
+	 */
+	static MappedStream* OpenFile(const char* filename, unsigned long offset, unsigned long size);
+};
+
+}
+
+#endif  // ! MAPPEDSTREAM_H
@@ -20,6 +20,7 @@
 
 #include "System/SlicedStream.h"
 
+#include "System/MappedStream.h"
 #include "System/MemoryStream.h"
 
 #include "win32def.h"
@@ -110,6 +111,11 @@ int SlicedStream::Seek(int newpos, int type)
 
 DataStream* SliceStream(DataStream* str, unsigned long startpos, unsigned long size, bool preservepos)
 {
+	// mapped files can hand out views without any copying or file I/O
+	MappedStream *mapped = dynamic_cast<MappedStream*>(str);
+	if (mapped) {
+		return mapped->Slice(startpos, size);
+	}
 	if (size <= 16384) {
 		// small (or empty) substream, just read it into a buffer instead of expensive file I/O
 		unsigned long oldpos;
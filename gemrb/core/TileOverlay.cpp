@@ -89,6 +89,8 @@ void TileOverlay::Draw(Region viewport, std::vector< TileOverlay*> &overlays, in
 	int dx = ( vp.x + vp.w + 63 ) / 64;
 	int dy = ( vp.y + vp.h + 63 ) / 64;
 
+	ieQword profile = core->ProfileStart();
+	vid->BeginTileBatch();
 	for (int y = sy; y < dy && y < h; y++) {
 		for (int x = sx; x < dx && x < w; x++) {
 			Tile* tile = tiles[( y* w ) + x];
@@ -134,6 +136,8 @@ void TileOverlay::Draw(Region viewport, std::vector< TileOverlay*> &overlays, in
 			}
 		}
 	}
+	vid->EndTileBatch();
+	core->ProfileEnd(PROFILE_TILES, profile);
 }
 
 }
@@ -66,7 +66,7 @@ inline unsigned int Variables::MyCompareKey(const char* key, const char *str) co
 	return 0;
 }
 
-inline unsigned int Variables::MyHashKey(const char* key) const
+static inline unsigned int HashVariable(const char* key)
 {
 	unsigned int nHash = 0;
 	for (int i = 0; key[i] && i < MAX_VARIABLE_LENGTH; i++) {
@@ -76,6 +76,19 @@ inline unsigned int Variables::MyHashKey(const char* key) const
 	}
 	return nHash;
 }
+
+inline unsigned int Variables::MyHashKey(const char* key) const
+{
+	return HashVariable( key );
+}
+
+//neither the hash nor the comparisons look past MAX_VARIABLE_LENGTH
+void VariableKey::Set(const char* key)
+{
+	strlcpy( name, key, sizeof(name) );
+	hash = HashVariable( name );
+	set = true;
+}
 /////////////////////////////////////////////////////////////////////////////
 // functions
 Variables::iterator Variables::GetNextAssoc(iterator rNextPosition, const char*& rKey,
@@ -108,6 +121,8 @@ Variables::iterator Variables::GetNextAssoc(iterator rNextPosition, const char*&
 	return ( iterator ) pAssocNext;
 }
 
+ieDword Variables::Changes = 0;
+
 Variables::Variables(int nBlockSize, int nHashTableSize)
 {
 	assert( nBlockSize > 0 );
@@ -183,6 +198,7 @@ void Variables::RemoveAll(ReleaseFun fun)
 		p = pNext;
 	}
 	m_pBlocks = NULL;
+	Changes++;
 }
 
 Variables::~Variables()
@@ -274,6 +290,30 @@ Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nHash)
 	return NULL;
 }
 
+Variables::MyAssoc* Variables::GetAssocAt(const VariableKey& key) const
+{
+	if (m_pHashTable == NULL) {
+		return NULL;
+	}
+
+	Variables::MyAssoc* pAssoc;
+	for (pAssoc = m_pHashTable[key.hash % m_nHashTableSize];
+		pAssoc != NULL;
+		pAssoc = pAssoc->pNext) {
+		if (m_lParseKey) {
+			if (!MyCompareKey( pAssoc->key, key.name) ) {
+				return pAssoc;
+			}
+		} else {
+			if (!strnicmp( pAssoc->key, key.name, MAX_VARIABLE_LENGTH )) {
+				return pAssoc;
+			}
+		}
+	}
+
+	return NULL;
+}
+
 int Variables::GetValueLength(const char* key) const
 {
 	unsigned int nHash;
@@ -338,6 +378,18 @@ bool Variables::Lookup(const char* key, ieDword& rValue) const
 	return true;
 }
 
+bool Variables::Lookup(const VariableKey& key, ieDword& rValue) const
+{
+	assert(m_type==GEM_VARIABLES_INT);
+	Variables::MyAssoc* pAssoc = GetAssocAt( key );
+	if (pAssoc == NULL) {
+		return false;
+	} // not in map
+
+	rValue = pAssoc->Value.nValue;
+	return true;
+}
+
 void Variables::SetAtCopy(const char* key, const char* value)
 {
 	size_t len = strlen(value)+1;
@@ -445,6 +497,7 @@ void Variables::SetAt(const char* key, ieDword value, bool nocreate)
 	if (pAssoc->key) {
 		pAssoc->Value.nValue = value;
 		pAssoc->nHashValue = nHash;
+		Changes++;
 	}
 }
 
@@ -473,6 +526,7 @@ void Variables::Remove(const char* key)
 	}
 	pAssoc->pNext = 0;
 	FreeAssoc(pAssoc);
+	Changes++;
 }
 
 void Variables::LoadInitialValues(const char* name)
@@ -39,6 +39,33 @@ typedef void (*ReleaseFun)(void *);
 #define GEM_VARIABLES_STRING   1
 #define GEM_VARIABLES_POINTER  2
 
+/**
+ * @class VariableKey
+ * A variable name with its hash computed once, for names looked up
+ * over and over again (script triggers). Mappings still compare the
+ * name itself, so a key matches exactly what the string would.
+ */
+
+class GEM_EXPORT VariableKey {
+public:
+	VariableKey()
+	{
+		name[0] = 0;
+		hash = 0;
+		set = false;
+	}
+	void Set(const char* key);
+	bool IsSet() const
+	{
+		return set;
+	}
+private:
+	char name[MAX_VARIABLE_LENGTH + 1];
+	unsigned int hash;
+	bool set;
+	friend class Variables;
+};
+
 class GEM_EXPORT Variables {
 protected:
 	// Association
@@ -93,6 +120,7 @@ public:
 	bool Lookup(const char* key, ieDword& rValue) const;
 	bool Lookup(const char* key, char*& dest) const;
 	bool Lookup(const char* key, void*& dest) const;
+	bool Lookup(const VariableKey& key, ieDword& rValue) const;
 
 	// Operations
 	void SetAtCopy(const char* key, const char* newValue);
@@ -103,6 +131,11 @@ public:
 	void Remove(const char* key);
 	void RemoveAll(ReleaseFun fun);
 	void InitHashTable(unsigned int hashSize, bool bAllocNow = true);
+	//bumped whenever an integer variable of any mapping changes
+	static ieDword GetChanges()
+	{
+		return Changes;
+	}
 
 	iterator GetNextAssoc(iterator rNextPosition, const char*& rKey,
 		ieDword& rValue) const;
@@ -119,10 +152,12 @@ protected:
 	MemBlock* m_pBlocks;
 	int m_nBlockSize;
 	int m_type; //could be string or ieDword 
+	static ieDword Changes;
 
 	Variables::MyAssoc* NewAssoc(const char* key);
 	void FreeAssoc(Variables::MyAssoc*);
 	Variables::MyAssoc* GetAssocAt(const char*, unsigned int&) const;
+	Variables::MyAssoc* GetAssocAt(const VariableKey&) const;
 	inline bool MyCopyKey(char*& dest, const char* key) const;
 	inline unsigned int MyCompareKey(const char* key, const char *str) const;
 	inline unsigned int MyHashKey(const char*) const;
@@ -44,6 +44,7 @@ Video::Video(void)
 	// MOUSE_GRAYED and MOUSE_DISABLED are the first 2 bits so shift the config value away from those.
 	// we care only about 2 bits at the moment so mask out the remainder
 	MouseFlags = ((core->MouseFeedback & 0x3) << 2);
+	FrameTime = core->MaxFPS > 0 ? 1000 / core->MaxFPS : 0;
 
 	// Initialize gamma correction tables
 	for (int i = 0; i < 256; i++) {
@@ -54,6 +55,7 @@ Video::Video(void)
 	// boring inits just to be extra clean
 	xCorr = yCorr = width = height = bpp = 0;
 	fullscreen = false;
+	dirtyScreen = true;
 	subtitlefont = NULL;
 	subtitlepal = NULL;
 }
@@ -81,6 +83,36 @@ void Video::SetScreenClip(const Region* clip)
 	}
 }
 
+//more than this and the whole screen is presented instead
+#define MAX_DIRTY_RECTS 32
+
+void Video::AddDirtyRect(const Region& rgn)
+{
+	if (dirtyScreen) return;
+
+	Region r = rgn.Intersect(Region(0, 0, width, height));
+	if (r.w <= 0 || r.h <= 0) return;
+
+	// hovering and text updates mostly redraw the same controls, so drop repeats
+	for (size_t i = 0; i < dirtyRects.size(); i++) {
+		const Region& d = dirtyRects[i];
+		if (r.x >= d.x && r.y >= d.y && r.x + r.w <= d.x + d.w && r.y + r.h <= d.y + d.h) {
+			return;
+		}
+	}
+	if (dirtyRects.size() >= MAX_DIRTY_RECTS) {
+		InvalidateScreen();
+		return;
+	}
+	dirtyRects.push_back(r);
+}
+
+void Video::InvalidateScreen()
+{
+	dirtyScreen = true;
+	dirtyRects.clear();
+}
+
 bool Video::ToggleFullscreenMode()
 {
 	return SetFullscreenMode(!fullscreen);
@@ -382,12 +414,8 @@ void Video::MoveViewportTo(int x, int y)
 
 void Video::InitSpriteCover(SpriteCover* sc, int flags)
 {
-	int i;
 	sc->flags = flags;
-	sc->pixels = new unsigned char[sc->Width * sc->Height];
-	for (i = 0; i < sc->Width*sc->Height; ++i)
-		sc->pixels[i] = 0;
-	
+	sc->Clear();
 }
 
 // flags: 0 - never dither (full cover)
@@ -395,11 +423,7 @@ void Video::InitSpriteCover(SpriteCover* sc, int flags)
 //	2 - always dither
 void Video::AddPolygonToSpriteCover(SpriteCover* sc, Wall_Polygon* poly)
 {
-	
-	// possible TODO: change the cover to use a set of intervals per line?
-	// advantages: faster
-	// disadvantages: makes the blitter much more complex
-	
+	// the cover is a set of intervals per line, see SpriteCover::Finish
 	int xoff = sc->worldx - sc->XPos;
 	int yoff = sc->worldy - sc->YPos;
 	
@@ -421,7 +445,6 @@ void Video::AddPolygonToSpriteCover(SpriteCover* sc, Wall_Polygon* poly)
 		Point& c = poly->points[redge];
 		Point& d = poly->points[(redge+1)%(poly->count)];
 		
-		unsigned char* line = sc->pixels + (y_top)*sc->Width;
 		for (int sy = y_top; sy < y_bot; ++sy) {
 			int py = sy + yoff;
 			
@@ -436,7 +459,7 @@ void Video::AddPolygonToSpriteCover(SpriteCover* sc, Wall_Polygon* poly)
 			
 			if (lt < 0) lt = 0;
 			if (rt > sc->Width) rt = sc->Width;
-			if (lt >= rt) { line += sc->Width; continue; } // clipped
+			if (lt >= rt) continue; // clipped
 			int dither;
 			
 			if (sc->flags == 1) {
@@ -444,27 +467,14 @@ void Video::AddPolygonToSpriteCover(SpriteCover* sc, Wall_Polygon* poly)
 			} else {
 				dither = sc->flags;
 			}
-			if (dither) {
-				unsigned char* pix = line + lt;
-				unsigned char* end = line + rt;
-				
-				if ((lt + xoff + sy + yoff) % 2) pix++; // CHECKME: aliasing?
-				for (; pix < end; pix += 2)
-					*pix = 1;
-			} else {
-				// we hope memset is faster
-				// condition: lt < rt is true
-				memset (line+lt, 1, rt-lt);
-			}
-			line += sc->Width;
+			sc->AddSpan(sy, lt, rt, dither != 0);
 		}
 	}
 }
 
 void Video::DestroySpriteCover(SpriteCover* sc)
 {
-	delete[] sc->pixels;
-	sc->pixels = NULL;
+	sc->Clear();
 }
 
 void Video::GetMousePos(int &x, int &y)
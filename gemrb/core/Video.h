@@ -33,6 +33,8 @@
 #include "Polygon.h"
 #include "ScriptedAnimation.h"
 
+#include <vector>
+
 namespace GemRB {
 
 class EventMgr;
@@ -108,6 +110,12 @@ protected:
 	Palette *subtitlepal;
 	Region subtitleregion;
 	Color fadeColor;
+	//shortest time between two frames in ms, 0 for no limit
+	unsigned long FrameTime;
+	//screen areas drawn since the last SwapBuffers, only these are presented
+	std::vector<Region> dirtyRects;
+	//the whole screen has to be presented
+	bool dirtyScreen;
 protected:
 	Region ClippedDrawingRect(const Region& target, const Region* clip = NULL) const;
 public:
@@ -141,6 +149,10 @@ public:
 										   Color* palette, bool cK = false, int index = 0) = 0;
 	virtual bool SupportsBAMSprites() { return false; }
 
+	/** Tiles blitted until EndTileBatch may be drawn later, possibly in parallel */
+	virtual void BeginTileBatch() {}
+	/** Finishes drawing the tiles blitted since BeginTileBatch */
+	virtual void EndTileBatch() {}
 	virtual void BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x, int y,
 						  const Region* clip, unsigned int flags) = 0;
 	virtual void BlitSprite(const Sprite2D* spr, int x, int y, bool anchor = false,
@@ -200,6 +212,10 @@ public:
 	void SetScreenClip(const Region* clip);
 	/** Gets Clip Rectangle */
 	const Region& GetScreenClip() { return screenClip; }
+	/** Marks a screen area as changed, so it is presented on the next SwapBuffers */
+	void AddDirtyRect(const Region& rgn);
+	/** Presents the whole screen on the next SwapBuffers */
+	void InvalidateScreen();
 	/** returns the current mouse coordinates */
 	void GetMousePos(int &x, int &y);
 	/** clicks the mouse forcibly */
@@ -61,6 +61,8 @@ typedef unsigned long int ieDword;
 typedef signed long int ieDwordSigned;
 #endif
 
+typedef unsigned __int64 ieQword;
+
 /** string reference into TLK file */
 typedef ieDword ieStrRef; 
 
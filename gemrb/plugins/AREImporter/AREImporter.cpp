@@ -244,6 +244,55 @@ bool AREImporter::Open(DataStream* stream)
 	return true;
 }
 
+//the maps of an area are named after its WED with a suffix, the suffix
+//wins over the end of an overlong WED name so the types stay distinct
+static void MakeMapResRef(ieResRef dest, const ieResRef wed, const char *suffix)
+{
+	size_t len = 0;
+	while (len < 6 && wed[len]) {
+		dest[len] = wed[len];
+		len++;
+	}
+	strlcpy(dest + len, suffix, sizeof(ieResRef) - len);
+}
+
+static void AddResource(std::vector<AreaResource> &resources, const ieResRef ResRef, SClass_ID Type)
+{
+	AreaResource res;
+	CopyResRef(res.ResRef, ResRef);
+	res.Type = Type;
+	resources.push_back(res);
+}
+
+void AREImporter::GetResources(std::vector<AreaResource> &resources)
+{
+	ieResRef TmpResRef;
+
+	AddResource(resources, WEDResRef, IE_WED_CLASS_ID);
+	AddResource(resources, WEDResRef, IE_TIS_CLASS_ID);
+	AddResource(resources, WEDResRef, IE_MOS_CLASS_ID);
+	MakeMapResRef(TmpResRef, WEDResRef, "LM");
+	AddResource(resources, TmpResRef, IE_BMP_CLASS_ID);
+	MakeMapResRef(TmpResRef, WEDResRef, "SR");
+	AddResource(resources, TmpResRef, IE_BMP_CLASS_ID);
+	MakeMapResRef(TmpResRef, WEDResRef, "HT");
+	AddResource(resources, TmpResRef, IE_BMP_CLASS_ID);
+
+	//only the actors that are not embedded in the area
+	for (unsigned int i = 0; i < ActorCount; i++) {
+		ieDword Flags, CreOffset;
+		str->Seek( ActorOffset + i * 0x110 + 0x28, GEM_STREAM_START );
+		str->ReadDword( &Flags );
+		str->Seek( ActorOffset + i * 0x110 + 0x80, GEM_STREAM_START );
+		str->ReadResRef( TmpResRef );
+		str->ReadDword( &CreOffset );
+		if (CreOffset != 0 && !(Flags&1) ) {
+			continue;
+		}
+		AddResource(resources, TmpResRef, IE_CRE_CLASS_ID);
+	}
+}
+
 //alter a map to the night/day version in case of an extended night map (bg2 specific)
 //return true, if change happened, in which case a movie is played by the Game object
 bool AREImporter::ChangeMap(Map *map, bool day_or_night)
@@ -254,7 +303,7 @@ bool AREImporter::ChangeMap(Map *map, bool day_or_night)
 	if (day_or_night) {
 		memcpy( TmpResRef, map->WEDResRef, 9);
 	} else {
-		snprintf( TmpResRef, 9, "%sN", map->WEDResRef);
+		MakeMapResRef(TmpResRef, map->WEDResRef, "N");
 	}
 	PluginHolder<TileMapMgr> tmm(IE_WED_CLASS_ID);
 	DataStream* wedfile = gamedata->GetResource( TmpResRef, IE_WED_CLASS_ID );
@@ -290,9 +339,9 @@ bool AREImporter::ChangeMap(Map *map, bool day_or_night)
 
 	//get the lightmap name
 	if (day_or_night) {
-		snprintf( TmpResRef, 9, "%sLM", map->WEDResRef);
+		MakeMapResRef(TmpResRef, map->WEDResRef, "LM");
 	} else {
-		snprintf( TmpResRef, 9, "%sLN", map->WEDResRef);
+		MakeMapResRef(TmpResRef, map->WEDResRef, "LN");
 	}
 
 	ResourceHolder<ImageMgr> lm(TmpResRef);
@@ -382,7 +431,7 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 	if (day_or_night) {
 		memcpy( TmpResRef, WEDResRef, 9);
 	} else {
-		snprintf( TmpResRef, 9, "%sN", WEDResRef);
+		MakeMapResRef(TmpResRef, WEDResRef, "N");
 	}
 
 	PluginHolder<TileMapMgr> tmm(IE_WED_CLASS_ID);
@@ -418,9 +467,9 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 	}
 
 	if (day_or_night) {
-		snprintf( TmpResRef, 9, "%sLM", WEDResRef);
+		MakeMapResRef(TmpResRef, WEDResRef, "LM");
 	} else {
-		snprintf( TmpResRef, 9, "%sLN", WEDResRef);
+		MakeMapResRef(TmpResRef, WEDResRef, "LN");
 	}
 
 	ResourceHolder<ImageMgr> lm(TmpResRef);
@@ -429,7 +478,7 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 		return NULL;
 	}
 
-	snprintf( TmpResRef, 9, "%sSR", WEDResRef);
+	MakeMapResRef(TmpResRef, WEDResRef, "SR");
 
 	ResourceHolder<ImageMgr> sr(TmpResRef);
 	if (!sr) {
@@ -437,7 +486,7 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 		return NULL;
 	}
 
-	snprintf( TmpResRef, 9, "%sHT", WEDResRef);
+	MakeMapResRef(TmpResRef, WEDResRef, "HT");
 
 	ResourceHolder<ImageMgr> hm(TmpResRef);
 	if (!hm) {
@@ -1038,11 +1087,11 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 			ab = actmgr->GetActor(0);
 			if(!ab)
 				continue;
-			map->AddActor(ab, false);
 			ab->Pos.x = XPos;
 			ab->Pos.y = YPos;
 			ab->Destination.x = XPos;
 			ab->Destination.y = YPos;
+			map->AddActor(ab, false);
 			ab->HomeLocation.x = XDes;
 			ab->HomeLocation.y = YDes;
 			ab->Spawned = Spawned;
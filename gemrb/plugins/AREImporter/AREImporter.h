@@ -65,6 +65,7 @@ public:
 	bool Open(DataStream* stream);
 	bool ChangeMap(Map *map, bool day_or_night);
 	Map* GetMap(const char* ResRef, bool day_or_night);
+	void GetResources(std::vector<AreaResource> &resources);
 	int GetStoredFileSize(Map *map);
 	/* stores an area in the Cache (swaps it out) */
 	int PutArea(DataStream *stream, Map *map);
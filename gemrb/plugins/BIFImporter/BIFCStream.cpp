@@ -0,0 +1,257 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "BIFCStream.h"
+
+#include "win32def.h"
+
+#include "Compressor.h"
+#include "Interface.h"
+#include "PluginMgr.h"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+using namespace GemRB;
+
+// decompressed blocks kept in memory per archive
+#define BIFC_CACHE_BUDGET (2 * 1024 * 1024)
+
+namespace {
+
+// writes into a buffer owned by the caller
+class BlockWriter : public DataStream {
+private:
+	char* data;
+public:
+	BlockWriter(char* data, unsigned long size) : data(data) { this->size = size; }
+	int Read(void* /*dest*/, unsigned int /*length*/) { return GEM_ERROR; }
+	int Write(const void* src, unsigned int length)
+	{
+		if (Pos + length > size) {
+			return GEM_ERROR;
+		}
+		memcpy(data + Pos, src, length);
+		Pos += length;
+		return length;
+	}
+	int Seek(int /*pos*/, int /*startpos*/) { return GEM_ERROR; }
+};
+
+struct Block {
+	ieDword offset; // in the uncompressed archive
+	ieDword length;
+	ieDword fileOffset; // of the compressed data
+	ieDword compressedLength;
+	char* data;
+	std::list<unsigned int>::iterator lru;
+};
+
+bool operator<(ieDword offset, const Block& block)
+{
+	return offset < block.offset;
+}
+
+}
+
+struct BIFCStream::BlockCache {
+	int refcount;
+	DataStream* file;
+	PluginHolder<Compressor> comp;
+	std::vector<Block> blocks;
+	// most recently used first
+	std::list<unsigned int> lru;
+	unsigned long used;
+	unsigned long total;
+
+	BlockCache(DataStream* file)
+		: refcount(1), file(file), comp(PLUGIN_COMPRESSION_ZLIB), used(0), total(0)
+	{
+	}
+
+	~BlockCache()
+	{
+		for (size_t i = 0; i < blocks.size(); i++) {
+			free(blocks[i].data);
+		}
+		delete file;
+	}
+
+	void Acquire() { refcount++; }
+	void Release() { if (!--refcount) delete this; }
+
+	// returns the index of the block holding the offset
+	unsigned int Find(unsigned long offset) const
+	{
+		std::vector<Block>::const_iterator it;
+		it = std::upper_bound(blocks.begin(), blocks.end(), (ieDword) offset);
+		return (unsigned int) (it - blocks.begin()) - 1;
+	}
+
+	const char* GetData(unsigned int idx)
+	{
+		Block& block = blocks[idx];
+		if (block.data) {
+			lru.splice(lru.begin(), lru, block.lru);
+			return block.data;
+		}
+
+		// make room, but always keep at least one block
+		while (lru.size() && used + block.length > BIFC_CACHE_BUDGET) {
+			Block& old = blocks[lru.back()];
+			free(old.data);
+			old.data = NULL;
+			used -= old.length;
+			lru.pop_back();
+		}
+
+		char* data = (char *) malloc(block.length);
+		BlockWriter out(data, block.length);
+		file->Seek(block.fileOffset, GEM_STREAM_START);
+		if (comp->Decompress(&out, file, block.compressedLength) != GEM_OK) {
+			free(data);
+			return NULL;
+		}
+		block.data = data;
+		used += block.length;
+		lru.push_front(idx);
+		block.lru = lru.begin();
+		return data;
+	}
+};
+
+BIFCStream::BIFCStream(BlockCache* cache)
+	: cache(cache)
+{
+	size = cache->total;
+	strlcpy(originalfile, cache->file->originalfile, _MAX_PATH);
+	strlcpy(filename, cache->file->filename, sizeof(filename));
+}
+
+BIFCStream::~BIFCStream(void)
+{
+	cache->Release();
+}
+
+DataStream* BIFCStream::Clone()
+{
+	cache->Acquire();
+	return new BIFCStream(cache);
+}
+
+int BIFCStream::Read(void* dest, unsigned int length)
+{
+	//we don't allow partial reads anyway, so it isn't a problem that
+	//i don't adjust length here (partial reads are evil)
+	if (Pos + length > size) {
+		return GEM_ERROR;
+	}
+
+	unsigned long pos = Pos + (Encrypted ? 2 : 0);
+	char* out = (char *) dest;
+	unsigned int left = length;
+	while (left) {
+		unsigned int idx = cache->Find(pos);
+		const char* data = cache->GetData(idx);
+		if (!data) {
+			return GEM_ERROR;
+		}
+		const Block& block = cache->blocks[idx];
+		unsigned int skip = pos - block.offset;
+		unsigned int chunk = block.length - skip;
+		if (chunk > left) {
+			chunk = left;
+		}
+		memcpy(out, data + skip, chunk);
+		out += chunk;
+		pos += chunk;
+		left -= chunk;
+	}
+	if (Encrypted) {
+		ReadDecrypted( dest, length );
+	}
+	Pos += length;
+	return length;
+}
+
+int BIFCStream::Write(const void* /*src*/, unsigned int /*length*/)
+{
+	return GEM_ERROR;
+}
+
+int BIFCStream::Seek(int newpos, int type)
+{
+	switch (type) {
+		case GEM_CURRENT_POS:
+			Pos += newpos;
+			break;
+
+		case GEM_STREAM_START:
+			Pos = newpos;
+			break;
+
+		case GEM_STREAM_END:
+			Pos = size - newpos;
+			break;
+
+		default:
+			return GEM_ERROR;
+	}
+	//we went past the buffer
+	if (Pos>size) {
+		print("[Streams]: Invalid seek position: %ld(limit: %ld)", Pos, size);
+		return GEM_ERROR;
+	}
+	return GEM_OK;
+}
+
+BIFCStream* BIFCStream::Open(DataStream* compressed)
+{
+	if (!core->IsAvailable( PLUGIN_COMPRESSION_ZLIB )) {
+		delete compressed;
+		return NULL;
+	}
+
+	BlockCache* cache = new BlockCache(compressed);
+	ieDword unCompBifSize;
+	compressed->ReadDword( &unCompBifSize );
+	// only the block headers are read, the data is skipped
+	while (cache->total < unCompBifSize) {
+		Block block;
+		if (compressed->ReadDword( &block.length ) == GEM_ERROR ||
+			compressed->ReadDword( &block.compressedLength ) == GEM_ERROR ||
+			!block.length) {
+			Log(ERROR, "BIFImporter", "Broken block table in %s.", compressed->originalfile);
+			cache->Release();
+			return NULL;
+		}
+		block.offset = cache->total;
+		block.fileOffset = compressed->GetPos();
+		block.data = NULL;
+		cache->blocks.push_back(block);
+		cache->total += block.length;
+		if (compressed->Seek( block.compressedLength, GEM_CURRENT_POS ) == GEM_ERROR) {
+			cache->Release();
+			return NULL;
+		}
+	}
+	return new BIFCStream(cache);
+}
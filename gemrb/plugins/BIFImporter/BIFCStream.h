@@ -0,0 +1,60 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef BIFCSTREAM_H
+#define BIFCSTREAM_H
+
+#include "System/DataStream.h"
+
+#include "globals.h"
+
+namespace GemRB {
+
+/**
+ * @class BIFCStream
+ * Reads a BIFC compressed archive as if it was uncompressed.
+ * The zlib blocks are only inflated when a read touches them and are
+ * kept in a least recently used cache with a fixed memory budget, so
+ * nothing has to be written to the cache directory. Clones share the
+ * block cache and the underlying file.
+ */
+
+class BIFCStream : public DataStream {
+private:
+	struct BlockCache;
+	BlockCache* cache;
+
+	BIFCStream(BlockCache* cache);
+public:
+	~BIFCStream(void);
+	DataStream* Clone();
+
+	int Read(void* dest, unsigned int length);
+	int Write(const void* src, unsigned int length);
+	int Seek(int pos, int startpos);
+public:
+	/** Indexes the blocks of a BIFC file positioned after its signature.
+	 *  Takes ownership of the stream, returns NULL on failure. */
+	static BIFCStream* Open(DataStream* compressed);
+};
+
+}
+
+#endif
@@ -20,20 +20,28 @@
 
 #include "BIFImporter.h"
 
+#include "BIFCStream.h"
+
 #include "win32def.h"
 
-#include "Compressor.h"
 #include "FileCache.h"
 #include "Interface.h"
 #include "PluginMgr.h"
-#include "System/SlicedStream.h"
 #include "System/FileStream.h"
+#include "System/MappedStream.h"
+#include "System/SlicedStream.h"
 
 using namespace GemRB;
 
+#define NO_ENTRY 0xffffffff
+
+//resources smaller than this are just read into memory by SliceStream
+#define MAP_THRESHOLD 16384
+
 BIFImporter::BIFImporter(void)
 {
 	stream = NULL;
+	mappable = false;
 	fentries = NULL;
 	tentries = NULL;
 }
@@ -51,51 +59,6 @@ BIFImporter::~BIFImporter(void)
 	}
 }
 
-DataStream* BIFImporter::DecompressBIFC(DataStream* compressed, const char* path)
-{
-	print("Decompressing");
-	if (!core->IsAvailable( PLUGIN_COMPRESSION_ZLIB ))
-		return NULL;
-	PluginHolder<Compressor> comp(PLUGIN_COMPRESSION_ZLIB);
-	ieDword unCompBifSize;
-	compressed->ReadDword( &unCompBifSize );
-	//print( "\nDecompressing file: [..........]" );
-	fflush(stdout);
-	FileStream out;
-	if (!out.Create(path)) {
-		Log(ERROR, "BIFImporter", "Cannot write %s.", path);
-		return NULL;
-	}
-	ieDword finalsize = 0;
-	int laststep = 0;
-	while (finalsize < unCompBifSize) {
-		ieDword complen, declen;
-		compressed->ReadDword( &declen );
-		compressed->ReadDword( &complen );
-		if (comp->Decompress( &out, compressed, complen ) != GEM_OK) {
-			return NULL;
-		}
-		finalsize = out.GetPos();
-		if (( int ) ( finalsize * ( 10.0 / unCompBifSize ) ) != laststep) {
-			laststep++;
-			/*
-			print( "\b\b\b\b\b\b\b\b\b\b\b" );
-			int l;
-
-			for (l = 0; l < laststep; l++)
-				print( "|" );
-			for (; l < 10; l++)//l starts from laststep
-				print( "." );
-			print( "]" );
-			fflush(stdout);
-			*/
-		}
-	}
-	//print("\n");
-	out.Close(); // This is necesary, since windows won't open the file otherwise.
-	return FileStream::OpenFile(path);
-}
-
 DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const char* /*path*/)
 {
 	ieDword fnlen, complen, declen;
@@ -136,8 +99,8 @@ int BIFImporter::OpenArchive(const char* path)
 			stream = DecompressBIF(file, cachePath);
 			delete file;
 		} else if (strncmp(Signature, "BIFCV1.0", 8) == 0) {
-			stream = DecompressBIFC(file, cachePath);
-			delete file;
+			// decompressed on demand, nothing is written to the cache
+			stream = BIFCStream::Open(file);
 		} else if (strncmp( Signature, "BIFFV1  ", 8 ) == 0) {
 			file->Seek(0, GEM_STREAM_START);
 			stream = file;
@@ -156,27 +119,39 @@ int BIFImporter::OpenArchive(const char* path)
 		return GEM_ERROR;
 	}
 
+	// plain archives on disk can hand out their big resources as mappings
+	mappable = dynamic_cast<FileStream*>(stream) != NULL;
 	ReadBIF();
 	return GEM_OK;
 }
 
+// maps the window of a resource, so it is read without copying it; the
+// regular file access is the fallback if mapping is impossible
+DataStream* BIFImporter::GetResourceStream(unsigned long offset, unsigned long size)
+{
+	if (mappable && size > MAP_THRESHOLD) {
+		DataStream* mapped = MappedStream::OpenFile(stream->originalfile, offset, size);
+		if (mapped) {
+			return mapped;
+		}
+	}
+	return SliceStream( stream, offset, size );
+}
+
 DataStream* BIFImporter::GetStream(unsigned long Resource, unsigned long Type)
 {
 	if (Type == IE_TIS_CLASS_ID) {
-		unsigned int srcResLoc = Resource & 0xFC000;
-		for (unsigned int i = 0; i < tentcount; i++) {
-			if (( tentries[i].resLocator & 0xFC000 ) == srcResLoc) {
-				return SliceStream( stream, tentries[i].dataOffset,
-							tentries[i].tileSize * tentries[i].tilesCount );
-			}
+		unsigned int srcResLoc = ( Resource & 0xFC000 ) >> 14;
+		if (srcResLoc < tindex.size() && tindex[srcResLoc] != NO_ENTRY) {
+			const TileEntry &entry = tentries[tindex[srcResLoc]];
+			return GetResourceStream( entry.dataOffset,
+						entry.tileSize * entry.tilesCount );
 		}
 	} else {
 		ieDword srcResLoc = Resource & 0x3FFF;
-		for (ieDword i = 0; i < fentcount; i++) {
-			if (( fentries[i].resLocator & 0x3FFF ) == srcResLoc) {
-				return SliceStream( stream, fentries[i].dataOffset,
-							fentries[i].fileSize );
-			}
+		if (srcResLoc < findex.size() && findex[srcResLoc] != NO_ENTRY) {
+			const FileEntry &entry = fentries[findex[srcResLoc]];
+			return GetResourceStream( entry.dataOffset, entry.fileSize );
 		}
 	}
 	return NULL;
@@ -189,6 +164,10 @@ void BIFImporter::ReadBIF(void)
 	stream->ReadDword( &tentcount );
 	stream->ReadDword( &foffset );
 	stream->Seek( foffset, GEM_STREAM_START );
+	delete[] fentries;
+	delete[] tentries;
+	findex.clear();
+	tindex.clear();
 	fentries = new FileEntry[fentcount];
 	tentries = new TileEntry[tentcount];
 	if (!fentries || !tentries) {
@@ -210,6 +189,15 @@ void BIFImporter::ReadBIF(void)
 		stream->ReadDword( &fentries[i].fileSize);
 		stream->ReadWord( &fentries[i].type);
 		stream->ReadWord( &fentries[i].u1);
+
+		// the first entry wins, like with the old linear search
+		ieDword loc = fentries[i].resLocator & 0x3FFF;
+		if (loc >= findex.size()) {
+			findex.resize(loc + 1, NO_ENTRY);
+		}
+		if (findex[loc] == NO_ENTRY) {
+			findex[loc] = i;
+		}
 	}
 	for (i=0;i<tentcount;i++) {
 		stream->ReadDword( &tentries[i].resLocator);
@@ -218,6 +206,14 @@ void BIFImporter::ReadBIF(void)
 		stream->ReadDword( &tentries[i].tileSize);
 		stream->ReadWord( &tentries[i].type);
 		stream->ReadWord( &tentries[i].u1);
+
+		ieDword loc = ( tentries[i].resLocator & 0xFC000 ) >> 14;
+		if (loc >= tindex.size()) {
+			tindex.resize(loc + 1, NO_ENTRY);
+		}
+		if (tindex[loc] == NO_ENTRY) {
+			tindex[loc] = i;
+		}
 	}
 }
 
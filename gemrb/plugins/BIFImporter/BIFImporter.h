@@ -27,6 +27,8 @@
 
 #include "System/DataStream.h"
 
+#include <vector>
+
 namespace GemRB {
 
 struct FileEntry {
@@ -51,7 +53,10 @@ private:
 	FileEntry* fentries;
 	TileEntry* tentries;
 	ieDword fentcount, tentcount;
+	//entry index by resource locator, filled in ReadBIF
+	std::vector<ieDword> findex, tindex;
 	DataStream* stream;
+	bool mappable;
 public:
 	BIFImporter(void);
 	~BIFImporter(void);
@@ -59,7 +64,7 @@ public:
 	DataStream* GetStream(unsigned long Resource, unsigned long Type);
 private:
 	static DataStream* DecompressBIF(DataStream* compressed, const char* path);
-	static DataStream* DecompressBIFC(DataStream* compressed, const char* path);
+	DataStream* GetResourceStream(unsigned long offset, unsigned long size);
 	void ReadBIF(void);
 };
 
@@ -177,7 +177,7 @@ static Condition* GetCondition(char* string)
 		if (!trigger) {
 			Log(WARNING, "DLGImporter", "Can't compile trigger: %s", lines[i]);
 		} else {
-			condition->triggers.push_back(trigger);
+			condition->AddTrigger(trigger);
 		}
 		free( lines[i] );
 	}
@@ -433,7 +433,7 @@ int fx_unknown (Scriptable* Owner, Actor* target, Effect* fx);//???
 // FIXME: Make this an ordered list, so we could use bsearch!
 static EffectDesc effectnames[] = {
 	{ "*Crash*", fx_crash, EFFECT_NO_ACTOR, -1 },
-	{ "AcidResistanceModifier", fx_acid_resistance_modifier, 0, -1 },
+	{ "AcidResistanceModifier", fx_acid_resistance_modifier, EFFECT_STATIC, -1 },
 	{ "ACVsCreatureType", fx_generic_effect, 0, -1 }, //0xdb
 	{ "ACVsDamageTypeModifier", fx_ac_vs_damage_type_modifier, 0, -1 },
 	{ "ACVsDamageTypeModifier2", fx_ac_vs_damage_type_modifier, 0, -1 }, // used in IWD
@@ -485,9 +485,9 @@ static EffectDesc effectnames[] = {
 	{ "ChantBadNonCumulative", fx_set_chantbad_state, 0, -1 },
 	{ "ChantNonCumulative", fx_set_chant_state, 0, -1 },
 	{ "ChaosShieldModifier", fx_chaos_shield_modifier, 0, -1 },
-	{ "CharismaModifier", fx_charisma_modifier, 0, -1 },
+	{ "CharismaModifier", fx_charisma_modifier, EFFECT_STATIC, -1 },
 	{ "CheckForBerserkModifier", fx_checkforberserk_modifier, 0, -1 },
-	{ "ColdResistanceModifier", fx_cold_resistance_modifier, 0, -1 },
+	{ "ColdResistanceModifier", fx_cold_resistance_modifier, EFFECT_STATIC, -1 },
 	{ "Color:BriefRGB", fx_brief_rgb, 0, -1 },
 	{ "Color:GlowRGB", fx_glow_rgb, 0, -1 },
 	{ "Color:DarkenRGB", fx_darken_rgb, 0, -1 },
@@ -496,7 +496,7 @@ static EffectDesc effectnames[] = {
 	{ "Color:SetRGBGlobal", fx_set_color_rgb_global, 0, -1 }, //08
 	{ "Color:PulseRGB", fx_set_color_pulse_rgb, 0, -1 }, //9
 	{ "Color:PulseRGBGlobal", fx_set_color_pulse_rgb_global, 0, -1 }, //9
-	{ "ConstitutionModifier", fx_constitution_modifier, 0, -1 },
+	{ "ConstitutionModifier", fx_constitution_modifier, EFFECT_STATIC, -1 },
 	{ "ControlCreature", fx_set_charmed_state, 0, -1 }, //0xf1 same as charm
 	{ "CreateContingency", fx_create_contingency, 0, -1 },
 	{ "CriticalHitModifier", fx_critical_hit_modifier, 0, -1 },
@@ -537,7 +537,7 @@ static EffectDesc effectnames[] = {
 	{ "Death3", fx_death, 0, -1 }, //(iwd2 effect too, Banish)
 	{ "DetectAlignment", fx_detect_alignment, 0, -1 },
 	{ "DetectIllusionsModifier", fx_detect_illusion_modifier, 0, -1 },
-	{ "DexterityModifier", fx_dexterity_modifier, 0, -1 },
+	{ "DexterityModifier", fx_dexterity_modifier, EFFECT_STATIC, -1 },
 	{ "DimensionDoor", fx_dimension_door, 0, -1 },
 	{ "DisableButton", fx_disable_button, 0, -1 }, //sets disable button flag
 	{ "DisableChunk", fx_disable_chunk_modifier, 0, -1 },
@@ -555,7 +555,7 @@ static EffectDesc effectnames[] = {
 	{ "DrainItems", fx_drain_items, 0, -1 },
 	{ "DrainSpells", fx_drain_spells, 0, -1 },
 	{ "DropWeapon", fx_drop_weapon, 0, -1 },
-	{ "ElectricityResistanceModifier", fx_electricity_resistance_modifier, 0, -1 },
+	{ "ElectricityResistanceModifier", fx_electricity_resistance_modifier, EFFECT_STATIC, -1 },
 	{ "ExistanceDelayModifier", fx_existance_delay_modifier , 0, -1 }, //unknown
 	{ "ExperienceModifier", fx_experience_modifier, 0, -1 },
 	{ "ExploreModifier", fx_explore_modifier, 0, -1 },
@@ -566,7 +566,7 @@ static EffectDesc effectnames[] = {
 	{ "FindFamiliar", fx_find_familiar, 0, -1 },
 	{ "FindTraps", fx_find_traps, 0, -1 },
 	{ "FindTrapsModifier", fx_find_traps_modifier, 0, -1 },
-	{ "FireResistanceModifier", fx_fire_resistance_modifier, 0, -1 },
+	{ "FireResistanceModifier", fx_fire_resistance_modifier, EFFECT_STATIC, -1 },
 	{ "FistDamageModifier", fx_fist_damage_modifier, 0, -1 },
 	{ "FistHitModifier", fx_fist_to_hit_modifier, 0, -1 },
 	{ "ForceSurgeModifier", fx_force_surge_modifier, 0, -1 },
@@ -582,7 +582,7 @@ static EffectDesc effectnames[] = {
 	{ "Icon:Remove", fx_remove_portrait_icon, 0, -1 },
 	{ "Identify", fx_identify, 0, -1 },
 	{ "IgnoreDialogPause", fx_ignore_dialogpause_modifier, 0, -1 },
-	{ "IntelligenceModifier", fx_intelligence_modifier, 0, -1 },
+	{ "IntelligenceModifier", fx_intelligence_modifier, EFFECT_STATIC, -1 },
 	{ "IntoxicationModifier", fx_intoxication_modifier, 0, -1 },
 	{ "InvisibleDetection", fx_see_invisible_modifier, 0, -1 },
 	{ "Item:CreateDays", fx_create_item_days, 0, -1 },
@@ -595,14 +595,14 @@ static EffectDesc effectnames[] = {
 	{ "KillCreatureType", fx_kill_creature_type, 0, -1 },
 	{ "LevelModifier", fx_level_modifier, 0, -1 },
 	{ "LevelDrainModifier", fx_leveldrain_modifier, 0, -1 },
-	{ "LoreModifier", fx_lore_modifier, 0, -1 },
+	{ "LoreModifier", fx_lore_modifier, EFFECT_STATIC, -1 },
 	{ "LuckModifier", fx_luck_modifier, EFFECT_NO_LEVEL_CHECK, -1 },
 	{ "LuckCumulative", fx_luck_cumulative, 0, -1 },
 	{ "LuckNonCumulative", fx_luck_non_cumulative, 0, -1 },
 	{ "MagicalColdResistanceModifier", fx_magical_cold_resistance_modifier, 0, -1 },
 	{ "MagicalFireResistanceModifier", fx_magical_fire_resistance_modifier, 0, -1 },
 	{ "MagicalRest", fx_magical_rest, 0, -1 },
-	{ "MagicDamageResistanceModifier", fx_magic_damage_resistance_modifier, 0, -1 },
+	{ "MagicDamageResistanceModifier", fx_magic_damage_resistance_modifier, EFFECT_STATIC, -1 },
 	{ "MagicResistanceModifier", fx_magic_resistance_modifier, 0, -1 },
 	{ "MassRaiseDead", fx_mass_raise_dead, EFFECT_NO_ACTOR, -1 },
 	{ "MaximumHPModifier", fx_maximum_hp_modifier, EFFECT_DICED, -1 },
@@ -687,11 +687,11 @@ static EffectDesc effectnames[] = {
 	{ "RestoreSpells", fx_restore_spell_level, 0, -1 },
 	{ "RetreatFrom2", fx_turn_undead, 0, -1 },
 	{ "RightHitModifier", fx_right_to_hit_modifier, 0, -1 },
-	{ "SaveVsBreathModifier", fx_save_vs_breath_modifier, 0, -1 },
-	{ "SaveVsDeathModifier", fx_save_vs_death_modifier, 0, -1 },
-	{ "SaveVsPolyModifier", fx_save_vs_poly_modifier, 0, -1 },
-	{ "SaveVsSpellsModifier", fx_save_vs_spell_modifier, 0, -1 },
-	{ "SaveVsWandsModifier", fx_save_vs_wands_modifier, 0, -1 },
+	{ "SaveVsBreathModifier", fx_save_vs_breath_modifier, EFFECT_STATIC, -1 },
+	{ "SaveVsDeathModifier", fx_save_vs_death_modifier, EFFECT_STATIC, -1 },
+	{ "SaveVsPolyModifier", fx_save_vs_poly_modifier, EFFECT_STATIC, -1 },
+	{ "SaveVsSpellsModifier", fx_save_vs_spell_modifier, EFFECT_STATIC, -1 },
+	{ "SaveVsWandsModifier", fx_save_vs_wands_modifier, EFFECT_STATIC, -1 },
 	{ "ScreenShake", fx_screenshake, EFFECT_NO_ACTOR, -1 },
 	{ "ScriptingState", fx_scripting_state, 0, -1 },
 	{ "Sequencer:Activate", fx_activate_spell_sequencer, EFFECT_PRESET_TARGET, -1 },
@@ -746,10 +746,10 @@ static EffectDesc effectnames[] = {
 	{ "State:Sleep", fx_set_unconscious_state, 0, -1 },
 	{ "State:Slowed", fx_set_slowed_state, 0, -1 },
 	{ "State:Stun", fx_set_stun_state, 0, -1 },
-	{ "StealthModifier", fx_stealth_modifier, 0, -1 },
+	{ "StealthModifier", fx_stealth_modifier, EFFECT_STATIC, -1 },
 	{ "StoneSkinModifier", fx_stoneskin_modifier, 0, -1 },
 	{ "StoneSkin2Modifier", fx_golem_stoneskin_modifier, 0, -1 },
-	{ "StrengthModifier", fx_strength_modifier, 0, -1 },
+	{ "StrengthModifier", fx_strength_modifier, EFFECT_STATIC, -1 },
 	{ "StrengthBonusModifier", fx_strength_bonus_modifier, 0, -1 },
 	{ "SummonCreature", fx_summon_creature, EFFECT_NO_ACTOR, -1 },
 	{ "RandomTeleport", fx_teleport_field, 0, -1 },
@@ -757,7 +757,7 @@ static EffectDesc effectnames[] = {
 	{ "TimelessState", fx_timeless_modifier, 0, -1 },
 	{ "Timestop", fx_timestop, 0, -1 },
 	{ "TitleModifier", fx_title_modifier, 0, -1 },
-	{ "ToHitModifier", fx_to_hit_modifier, 0, -1 },
+	{ "ToHitModifier", fx_to_hit_modifier, EFFECT_STATIC, -1 },
 	{ "ToHitBonusModifier", fx_to_hit_bonus_modifier, 0, -1 },
 	{ "ToHitVsCreature", fx_generic_effect, 0, -1 },
 	{ "TrackingModifier", fx_tracking_modifier, 0, -1 },
@@ -773,7 +773,7 @@ static EffectDesc effectnames[] = {
 	{ "VisualSpellHit", fx_visual_spell_hit, 0, -1 },
 	{ "WildSurgeModifier", fx_wild_surge_modifier, 0, -1 },
 	{ "WingBuffet", fx_wing_buffet, 0, -1 },
-	{ "WisdomModifier", fx_wisdom_modifier, 0, -1 },
+	{ "WisdomModifier", fx_wisdom_modifier, EFFECT_STATIC, -1 },
 	{ "WizardSpellSlotsModifier", fx_bonus_wizard_spells, 0, -1 },
 	{ NULL, NULL, 0, 0 },
 };
@@ -30,6 +30,9 @@
 
 using namespace GemRB;
 
+// the number of archives kept open at a time
+#define MAX_OPEN_ARCHIVES 16
+
 KEYImporter::KEYImporter(void)
 {
 	description = NULL;
@@ -207,6 +210,29 @@ bool KEYImporter::HasResource(const char* resname, const ResourceDesc &type)
 	return HasResource(resname, type.GetKeyType());
 }
 
+PluginHolder<IndexedArchive> KEYImporter::GetArchive(unsigned int bifnum)
+{
+	std::list<KEYCache>::iterator it;
+	for (it = archives.begin(); it != archives.end(); ++it) {
+		if (it->bifnum == bifnum) {
+			archives.splice(archives.begin(), archives, it);
+			return it->plugin;
+		}
+	}
+
+	PluginHolder<IndexedArchive> ai(IE_BIF_CLASS_ID);
+	if (ai->OpenArchive( biffiles[bifnum].path ) == GEM_ERROR) {
+		return PluginHolder<IndexedArchive>();
+	}
+	if (archives.size() >= MAX_OPEN_ARCHIVES) {
+		archives.pop_back();
+	}
+	archives.push_front(KEYCache());
+	archives.front().bifnum = bifnum;
+	archives.front().plugin = ai;
+	return ai;
+}
+
 DataStream* KEYImporter::GetStream(const char *resname, ieWord type)
 {
 	if (type == 0)
@@ -224,8 +250,8 @@ DataStream* KEYImporter::GetStream(const char *resname, ieWord type)
 		return NULL;
 	}
 
-	PluginHolder<IndexedArchive> ai(IE_BIF_CLASS_ID);
-	if (ai->OpenArchive( biffiles[bifnum].path ) == GEM_ERROR) {
+	PluginHolder<IndexedArchive> ai = GetArchive(bifnum);
+	if (!ai) {
 		print("Cannot open archive %s", biffiles[bifnum].path);
 		return NULL;
 	}
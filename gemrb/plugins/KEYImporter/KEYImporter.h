@@ -28,6 +28,7 @@
 
 #include "StringMap.h"
 
+#include <list>
 #include <vector>
 
 namespace GemRB {
@@ -131,9 +132,13 @@ class KEYImporter : public ResourceSource {
 private:
 	std::vector< BIFEntry> biffiles;
 	KEYMap resources;
+	/** recently used archives, kept open (most recent first) */
+	std::list< KEYCache> archives;
 
 	/** Gets the stream assoicated to a RESKey */
 	DataStream *GetStream(const char *resname, ieWord type);
+	/** Returns the opened archive, opening it if it isn't cached */
+	PluginHolder<IndexedArchive> GetArchive(unsigned int bifnum);
 public:
 	KEYImporter(void);
 	~KEYImporter(void);
@@ -28,6 +28,7 @@ using namespace GemRB;
 SDL12VideoDriver::SDL12VideoDriver(void)
 {
 	overlay = NULL;
+	lastFade = false;
 }
 
 SDL12VideoDriver::~SDL12VideoDriver(void)
@@ -117,6 +118,8 @@ void SDL12VideoDriver::InitMovieScreen(int &w, int &h, bool yuv)
 
 void SDL12VideoDriver::DestroyMovieScreen()
 {
+	// the movie drew directly to the display
+	InvalidateScreen();
 	if (overlay) {
 		SDL_FreeYUVOverlay(overlay);
 		overlay = NULL;
@@ -172,6 +175,7 @@ bool SDL12VideoDriver::SetFullscreenMode(bool set)
 		fullscreen=set;
 		// FIXME: SDL_WM_ToggleFullScreen only works on X11. use SDL_SetVideoMode()
 		SDL_WM_ToggleFullScreen( disp );
+		InvalidateScreen();
 		//readjust mouse to original position
 		MoveMouse(CursorPos.x, CursorPos.y);
 		//synchronise internal variable
@@ -183,7 +187,24 @@ bool SDL12VideoDriver::SetFullscreenMode(bool set)
 
 int SDL12VideoDriver::SwapBuffers(void)
 {
-	SDL_BlitSurface( backBuf, NULL, disp, NULL );
+	// static screens only copy what changed, see Video::AddDirtyRect
+	bool partial = !dirtyScreen && !fadeColor.a && !lastFade;
+	lastFade = fadeColor.a != 0;
+	std::vector<SDL_Rect> updated;
+	if (partial) {
+		updated.reserve(dirtyRects.size() * 2);
+		for (size_t i = 0; i < dirtyRects.size(); i++) {
+			SDL_Rect rect = RectFromRegion(dirtyRects[i]);
+			updated.push_back(rect);
+			SDL_BlitSurface( backBuf, &updated.back(), disp, &rect );
+		}
+	} else {
+		SDL_BlitSurface( backBuf, NULL, disp, NULL );
+	}
+	// the cursor and tooltip drawn below add themselves for the next frame
+	dirtyRects.clear();
+	dirtyScreen = false;
+
 	if (fadeColor.a) {
 		SDL_SetAlpha( extra, SDL_SRCALPHA, fadeColor.a );
 		SDL_Rect src = {
@@ -201,7 +222,16 @@ int SDL12VideoDriver::SwapBuffers(void)
 	int ret = SDLVideoDriver::SwapBuffers();
 	backBuf = tmp;
 
-	SDL_Flip( disp );
+	if (partial) {
+		for (size_t i = 0; i < dirtyRects.size(); i++) {
+			updated.push_back(RectFromRegion(dirtyRects[i]));
+		}
+		if (!updated.empty()) {
+			SDL_UpdateRects( disp, (int) updated.size(), &updated[0] );
+		}
+	} else {
+		SDL_Flip( disp );
+	}
 	return ret;
 }
 
@@ -272,6 +302,9 @@ int SDL12VideoDriver::ProcessEvent(const SDL_Event & event)
 					EvntManager->OnSpecialKeyPress( GEM_MOUSEOUT );
 			}
 			break;
+		case SDL_VIDEOEXPOSE:
+			InvalidateScreen();
+			break;
 		default:
 			return SDLVideoDriver::ProcessEvent(event);
 	}
@@ -29,6 +29,8 @@ class SDL12VideoDriver : public SDLVideoDriver {
 private:
 	/* yuv overlay for bink movie */
 	SDL_Overlay *overlay;
+	/* the previous frame was faded, so it has to be fully replaced */
+	bool lastFade;
 public:
 	SDL12VideoDriver(void);
 	~SDL12VideoDriver(void);
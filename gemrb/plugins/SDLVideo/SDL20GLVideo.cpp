@@ -37,6 +37,10 @@ int GLVideoDriver::CreateDisplay(int w, int h, int bpp, bool fs, const char* tit
 {
 	fullscreen=fs;
 	width = w, height = h;
+	// tiles are drawn as textures here, so neither the strip workers
+	// nor the converted tile cache would ever be used
+	StopRenderWorkers();
+	tileCacheBudget = 0;
 
 	Log(MESSAGE, "SDL 2 GL Driver", "Creating display");
 	Uint32 winFlags = SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL;
@@ -541,17 +545,16 @@ void GLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y, unsigned i
 			int trueX = cover->XPos - glSprite->XPos;
 			int trueY = cover->YPos - glSprite->YPos;
 			Uint8* data = new Uint8[glSprite->Width*glSprite->Height];
-			Uint8* coverPointer = &cover->pixels[trueY*glSprite->Width + trueX];
 			Uint8* dataPointer = data;
+			CoverLine covered;
 			for(int h=0; h<glSprite->Height; h++)
 			{
+				covered.Start(cover, trueY + h);
 				for(int w=0; w<glSprite->Width; w++)
 				{
-					*dataPointer = !(*coverPointer) * 255;
+					*dataPointer = !covered.Covered(trueX + w) * 255;
 					dataPointer++;
-					coverPointer++;
 				}
-				coverPointer += cover->Width - glSprite->Width;
 			}
 			glActiveTexture(GL_TEXTURE2);
 			glGenTextures(1, &coverTexture);
@@ -26,6 +26,8 @@
 #include "GUI/Console.h"
 #include "GUI/GameControl.h" // for TargetMode (contextual information for touch inputs)
 
+#include <algorithm>
+
 using namespace GemRB;
 
 //touch gestures
@@ -186,6 +188,7 @@ void SDL20VideoDriver::InitMovieScreen(int &w, int &h, bool yuv)
 void SDL20VideoDriver::DestroyMovieScreen()
 {
 	if (screenTexture) SDL_DestroyTexture(screenTexture);
+	InvalidateScreen();
 	// recreate the texture for gameplay
 	// temporarily hardcoding format: see 91becce77374e96da38eb0d9a45f119a74b07cd4
 	Uint32 format = SDL_PIXELFORMAT_ABGR8888;
@@ -329,7 +332,31 @@ int SDL20VideoDriver::SwapBuffers(void)
 {
 	int ret = SDLVideoDriver::SwapBuffers();
 
-	SDL_UpdateTexture(screenTexture, NULL, backBuf->pixels, backBuf->pitch);
+	if (!dirtyScreen && dirtyRects.empty()) {
+		// nothing was drawn, the last frame is still on screen
+		return ret;
+	}
+	if (dirtyScreen) {
+		SDL_UpdateTexture(screenTexture, NULL, backBuf->pixels, backBuf->pitch);
+	} else {
+		// the texture keeps the old frame, so only upload what changed
+		Region bounds = dirtyRects[0];
+		for (size_t i = 1; i < dirtyRects.size(); i++) {
+			const Region& r = dirtyRects[i];
+			int x2 = std::max(bounds.x + bounds.w, r.x + r.w);
+			int y2 = std::max(bounds.y + bounds.h, r.y + r.h);
+			bounds.x = std::min(bounds.x, r.x);
+			bounds.y = std::min(bounds.y, r.y);
+			bounds.w = x2 - bounds.x;
+			bounds.h = y2 - bounds.y;
+		}
+		SDL_Rect rect = { bounds.x, bounds.y, bounds.w, bounds.h };
+		const Uint8* pixels = (const Uint8*) backBuf->pixels + bounds.y * backBuf->pitch
+			+ bounds.x * backBuf->format->BytesPerPixel;
+		SDL_UpdateTexture(screenTexture, &rect, pixels, backBuf->pitch);
+	}
+	dirtyRects.clear();
+	dirtyScreen = false;
 	/*
 	 Commenting this out because I get better performance (on iOS) with SDL_UpdateTexture
 	 Don't know how universal it is yet so leaving this in commented out just in case
@@ -700,6 +727,10 @@ int SDL20VideoDriver::ProcessEvent(const SDL_Event & event)
 					sleep(1);
 #endif
 					core->GetAudioDrv()->Resume();//this is for ANDROID mostly
+					InvalidateScreen();
+					break;
+				case SDL_WINDOWEVENT_EXPOSED:
+					InvalidateScreen();
 					break;
 					/*
 				case SDL_WINDOWEVENT_RESIZED: //SDL 1.2
@@ -774,6 +805,7 @@ bool SDL20VideoDriver::SetFullscreenMode(bool set)
 {
 	if (SDL_SetWindowFullscreen(window, (SDL_bool)set) == GEM_OK) {
 		fullscreen = set;
+		InvalidateScreen();
 		return true;
 	}
 	return false;
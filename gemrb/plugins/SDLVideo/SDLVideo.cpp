@@ -66,11 +66,19 @@ SDLVideoDriver::SDLVideoDriver(void)
 	subtitlestrref = 0;
 	subtitletext = NULL;
 	disp = NULL;
+	tileCacheSize = tileCacheBudget = 0;
+	tileFrame = 0;
+	batchTiles = false;
+	stripsDone = NULL;
+	stopWorkers = false;
+	batchTop = stripHeight = 0;
 }
 
 SDLVideoDriver::~SDLVideoDriver(void)
 {
 	delete subtitletext;
+	StopRenderWorkers();
+	FlushTileCache();
 
 	if(backBuf) SDL_FreeSurface( backBuf );
 	if(extra) SDL_FreeSurface( extra );
@@ -86,6 +94,14 @@ SDLVideoDriver::~SDLVideoDriver(void)
 int SDLVideoDriver::Init(void)
 {
 	//print("[SDLVideoDriver]: Init...");
+	// benchmarks don't need a display, unless a video driver was asked for
+	if (core->BenchmarkTicks > 0 && !SDL_getenv("SDL_VIDEODRIVER")) {
+#if SDL_VERSION_ATLEAST(1, 3, 0)
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+#else
+		SDL_putenv((char *) "SDL_VIDEODRIVER=dummy");
+#endif
+	}
 	if (SDL_InitSubSystem( SDL_INIT_VIDEO ) == -1) {
 		//print("[ERROR]");
 		return GEM_ERROR;
@@ -93,6 +109,12 @@ int SDLVideoDriver::Init(void)
 	if (!(MouseFlags&MOUSE_HIDDEN)) {
 		SDL_ShowCursor( SDL_DISABLE );
 	}
+	if (core->TileCacheSize > 0) {
+		tileCacheBudget = (size_t) core->TileCacheSize * 1024 * 1024;
+	}
+	if (core->RenderThreads > 1) {
+		StartRenderWorkers(core->RenderThreads);
+	}
 	return GEM_OK;
 }
 
@@ -100,16 +122,19 @@ int SDLVideoDriver::SwapBuffers(void)
 {
 	unsigned long time;
 	time = GetTickCount();
-	if (( time - lastTime ) < 33) {
+	if (( time - lastTime ) < FrameTime) {
 #ifndef NOFPSLIMIT
-		SDL_Delay( 33 - (time - lastTime) );
+		SDL_Delay( FrameTime - (time - lastTime) );
 #endif
 		time = GetTickCount();
 	}
 	lastTime = time;
+	tileFrame++;
 
 	if (Cursor[CursorIndex] && !(MouseFlags & (MOUSE_DISABLED | MOUSE_HIDDEN))) {
-		
+		const Sprite2D* cursor = Cursor[CursorIndex];
+		AddDirtyRect(Region(CursorPos.x - cursor->XPos, CursorPos.y - cursor->YPos, cursor->Width, cursor->Height));
+
 		if (MouseFlags&MOUSE_GRAYED) {
 			//used for greyscale blitting, fadeColor is unused
 			BlitGameSprite(Cursor[CursorIndex], CursorPos.x, CursorPos.y, BLIT_GREY, fadeColor, NULL, NULL, NULL, true);
@@ -391,6 +416,86 @@ Sprite2D* SDLVideoDriver::CreatePalettedSprite(int w, int h, int bpp, void* pixe
 	return spr;
 }
 
+// returns NULL when the tile can't be cached without evicting one drawn in this frame
+Uint8* SDLVideoDriver::GetCachedTile(const TileKey& key, bool& fresh)
+{
+	std::map<TileKey, TileList::iterator>::iterator i = tileIndex.find(key);
+	if (i != tileIndex.end()) {
+		tileLRU.splice(tileLRU.begin(), tileLRU, i->second);
+		i->second->frame = tileFrame;
+		fresh = false;
+		return i->second->pixels;
+	}
+
+	size_t size = 64 * 64 * backBuf->format->BytesPerPixel;
+	// tiles of this frame may still be queued in a batch, so they are kept;
+	// if they alone fill the budget, caching more would only thrash it
+	TrimTileCache(size);
+	if (tileCacheSize + size > GetTileCacheBudget()) {
+		return NULL;
+	}
+
+	CachedTile tile;
+	tile.key = key;
+	tile.pixels = (Uint8*) malloc(size);
+	tile.frame = tileFrame;
+	// hold on to the sprite, so its address can't be reused by another tile
+	const_cast<Sprite2D*>(key.spr)->acquire();
+	tileLRU.push_front(tile);
+	tileIndex[key] = tileLRU.begin();
+	tileCacheSize += size;
+	fresh = true;
+	return tile.pixels;
+}
+
+// the configured size, but at least twice what covers the viewport,
+// so the base layer and the overlays of a frame fit together
+size_t SDLVideoDriver::GetTileCacheBudget() const
+{
+	size_t size = 64 * 64 * backBuf->format->BytesPerPixel;
+	size_t visible = (size_t) ((Viewport.w + 63) / 64 + 1) * ((Viewport.h + 63) / 64 + 1);
+	if (visible * size * 2 > tileCacheBudget) {
+		return visible * size * 2;
+	}
+	return tileCacheBudget;
+}
+
+// evicts the least recently used tiles that weren't drawn in this frame
+void SDLVideoDriver::TrimTileCache(size_t reserve)
+{
+	size_t size = 64 * 64 * backBuf->format->BytesPerPixel;
+	size_t budget = GetTileCacheBudget();
+	while (!tileLRU.empty() && tileCacheSize + reserve > budget && tileLRU.back().frame != tileFrame) {
+		CachedTile& old = tileLRU.back();
+		tileIndex.erase(old.key);
+		const_cast<Sprite2D*>(old.key.spr)->release();
+		free(old.pixels);
+		tileLRU.pop_back();
+		tileCacheSize -= size;
+	}
+}
+
+void SDLVideoDriver::FlushTileCache()
+{
+	TileList::iterator i;
+	for (i = tileLRU.begin(); i != tileLRU.end(); ++i) {
+		const_cast<Sprite2D*>(i->key.spr)->release();
+		free(i->pixels);
+	}
+	tileLRU.clear();
+	tileIndex.clear();
+	tileCacheSize = 0;
+}
+
+template<class Tinter>
+static void ConvertTileTo(SDL_Surface* target, const Uint8* data, const SDL_Color* pal, Tinter& T, Uint8* out)
+{
+	if (target->format->BytesPerPixel == 4)
+		ConvertTile<Uint32>(target->format, data, pal, T, (Uint32*) out);
+	else
+		ConvertTile<Uint16>(target->format, data, pal, T, (Uint16*) out);
+}
+
 void SDLVideoDriver::BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x, int y, const Region* clip, unsigned int flags)
 {
 	if (spr->BAM) {
@@ -398,73 +503,149 @@ void SDLVideoDriver::BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x,
 		return;
 	}
 
-	x -= Viewport.x;
-	y -= Viewport.y;
-
-	Region fClip = ClippedDrawingRect(Region(x, y, 64, 64), clip);
+	TileCommand cmd;
+	cmd.x = x - Viewport.x;
+	cmd.y = y - Viewport.y;
+	cmd.clip = ClippedDrawingRect(Region(cmd.x, cmd.y, 64, 64), clip);
+	if (cmd.clip.w <= 0 || cmd.clip.h <= 0) {
+		return;
+	}
+	cmd.flags = flags;
 
-	const Uint8* data = (const Uint8*)spr->pixels;
-	const SDL_Color* pal = reinterpret_cast<const SDL_Color*>(spr->GetPaletteColors());
+	cmd.data = (const Uint8*)spr->pixels;
+	cmd.pal = reinterpret_cast<const SDL_Color*>(spr->GetPaletteColors());
 
-	const Uint8* mask_data = NULL;
-	Uint32 ck = 0;
+	cmd.mask = NULL;
+	cmd.ck = 0;
 	if (mask) {
-		mask_data = (Uint8*) mask->pixels;
-		ck = mask->GetColorKey();
+		cmd.mask = (Uint8*) mask->pixels;
+		cmd.ck = mask->GetColorKey();
 	}
 
-	bool tint = false;
+	cmd.tint = false;
 	Color tintcol = {255,255,255,0};
+	cmd.tintcol = tintcol;
 
 	if (core->GetGame()) {
 		const Color* totint = core->GetGame()->GetGlobalTint();
 		if (totint) {
-			tintcol = *totint;
-			tint = true;
+			cmd.tintcol = *totint;
+			cmd.tint = true;
+		}
+	}
+
+	// the palette and tint only depend on the tile, so with the cache enabled
+	// the conversion is done once and only the blending is left per frame
+	cmd.converted = NULL;
+	if (tileCacheBudget) {
+		TileKey key;
+		key.spr = spr;
+		key.tint = cmd.tint ? (cmd.tintcol.r | cmd.tintcol.g << 8 | cmd.tintcol.b << 16 | 1 << 24) : 0;
+		key.flags = (flags & (TILE_GREY|TILE_SEPIA)) | backBuf->format->BytesPerPixel << 24;
+		bool fresh;
+		cmd.converted = GetCachedTile(key, fresh);
+		if (cmd.converted && fresh) {
+			if (flags & TILE_GREY) {
+				TRTinter_Grey T(cmd.tintcol);
+				ConvertTileTo(backBuf, cmd.data, cmd.pal, T, cmd.converted);
+			} else if (flags & TILE_SEPIA) {
+				TRTinter_Sepia T(cmd.tintcol);
+				ConvertTileTo(backBuf, cmd.data, cmd.pal, T, cmd.converted);
+			} else if (cmd.tint) {
+				TRTinter_Tint T(cmd.tintcol);
+				ConvertTileTo(backBuf, cmd.data, cmd.pal, T, cmd.converted);
+			} else {
+				TRTinter_NoTint T;
+				ConvertTileTo(backBuf, cmd.data, cmd.pal, T, cmd.converted);
+			}
+		}
+	}
+
+	if (batchTiles) {
+		tileBatch.push_back(cmd);
+	} else {
+		DrawTile(cmd, cmd.clip.y, cmd.clip.y + cmd.clip.h);
+	}
+}
+
+// draws the rows of the tile between top and bottom
+void SDLVideoDriver::DrawTile(const TileCommand& cmd, int top, int bottom)
+{
+	int y1 = cmd.clip.y > top ? cmd.clip.y : top;
+	int y2 = cmd.clip.y + cmd.clip.h < bottom ? cmd.clip.y + cmd.clip.h : bottom;
+	if (y1 >= y2) {
+		return;
+	}
+	int x = cmd.x;
+	int y = cmd.y;
+	int rx = cmd.clip.x - x;
+	int ry = y1 - y;
+	int w = cmd.clip.w;
+	int h = y2 - y1;
+	Uint8 ck = (Uint8) cmd.ck;
+
+	if (cmd.converted) {
+
+#define DO_BLIT \
+		if (backBuf->format->BytesPerPixel == 4) \
+			BlitTile_converted<Uint32>(backBuf, x, y, rx, ry, w, h, (const Uint32*) cmd.converted, cmd.mask, ck, B); \
+		else \
+			BlitTile_converted<Uint16>(backBuf, x, y, rx, ry, w, h, (const Uint16*) cmd.converted, cmd.mask, ck, B); \
+
+		if (cmd.flags & TILE_HALFTRANS) {
+			TRBlender_HalfTrans B(backBuf->format);
+			DO_BLIT
+		} else {
+			TRBlender_Opaque B(backBuf->format);
+			DO_BLIT
 		}
+
+#undef DO_BLIT
+
+		return;
 	}
 
 #define DO_BLIT \
 		if (backBuf->format->BytesPerPixel == 4) \
-			BlitTile_internal<Uint32>(backBuf, x, y, fClip.x - x, fClip.y - y, fClip.w, fClip.h, data, pal, mask_data, ck, T, B); \
+			BlitTile_internal<Uint32>(backBuf, x, y, rx, ry, w, h, cmd.data, cmd.pal, cmd.mask, ck, T, B); \
 		else \
-			BlitTile_internal<Uint16>(backBuf, x, y, fClip.x - x, fClip.y - y, fClip.w, fClip.h, data, pal, mask_data, ck, T, B); \
+			BlitTile_internal<Uint16>(backBuf, x, y, rx, ry, w, h, cmd.data, cmd.pal, cmd.mask, ck, T, B); \
 
-	if (flags & TILE_GREY) {
+	if (cmd.flags & TILE_GREY) {
 
-		if (flags & TILE_HALFTRANS) {
+		if (cmd.flags & TILE_HALFTRANS) {
 			TRBlender_HalfTrans B(backBuf->format);
 
-			TRTinter_Grey T(tintcol);
+			TRTinter_Grey T(cmd.tintcol);
 			DO_BLIT
 		} else {
 			TRBlender_Opaque B(backBuf->format);
 
-			TRTinter_Grey T(tintcol);
+			TRTinter_Grey T(cmd.tintcol);
 			DO_BLIT
 		}
 
-	} else if (flags & TILE_SEPIA) {
+	} else if (cmd.flags & TILE_SEPIA) {
 
-		if (flags & TILE_HALFTRANS) {
+		if (cmd.flags & TILE_HALFTRANS) {
 			TRBlender_HalfTrans B(backBuf->format);
 
-			TRTinter_Sepia T(tintcol);
+			TRTinter_Sepia T(cmd.tintcol);
 			DO_BLIT
 		} else {
 			TRBlender_Opaque B(backBuf->format);
 
-			TRTinter_Sepia T(tintcol);
+			TRTinter_Sepia T(cmd.tintcol);
 			DO_BLIT
 		}
 
 	} else {
 
-		if (flags & TILE_HALFTRANS) {
+		if (cmd.flags & TILE_HALFTRANS) {
 			TRBlender_HalfTrans B(backBuf->format);
 
-			if (tint) {
-				TRTinter_Tint T(tintcol);
+			if (cmd.tint) {
+				TRTinter_Tint T(cmd.tintcol);
 				DO_BLIT
 			} else {
 				TRTinter_NoTint T;
@@ -473,8 +654,8 @@ void SDLVideoDriver::BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x,
 		} else {
 			TRBlender_Opaque B(backBuf->format);
 
-			if (tint) {
-				TRTinter_Tint T(tintcol);
+			if (cmd.tint) {
+				TRTinter_Tint T(cmd.tintcol);
 				DO_BLIT
 			} else {
 				TRTinter_NoTint T;
@@ -488,6 +669,117 @@ void SDLVideoDriver::BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x,
 
 }
 
+void SDLVideoDriver::BeginTileBatch()
+{
+	batchTiles = true;
+	tileBatch.clear();
+}
+
+void SDLVideoDriver::EndTileBatch()
+{
+	batchTiles = false;
+	if (tileBatch.empty()) {
+		return;
+	}
+
+	if (renderWorkers.empty()) {
+		for (size_t i = 0; i < tileBatch.size(); i++) {
+			const TileCommand& cmd = tileBatch[i];
+			DrawTile(cmd, cmd.clip.y, cmd.clip.y + cmd.clip.h);
+		}
+	} else {
+		// every strip runs the whole batch in order, clipped to its own rows,
+		// so overlapping tiles keep their order
+		int top = tileBatch[0].clip.y;
+		int bottom = top + tileBatch[0].clip.h;
+		for (size_t i = 1; i < tileBatch.size(); i++) {
+			const Region& clip = tileBatch[i].clip;
+			if (clip.y < top) top = clip.y;
+			if (clip.y + clip.h > bottom) bottom = clip.y + clip.h;
+		}
+		int strips = (int) renderWorkers.size() + 1;
+		batchTop = top;
+		stripHeight = (bottom - top + strips - 1) / strips;
+
+		for (size_t i = 0; i < renderWorkers.size(); i++) {
+			SDL_SemPost(renderWorkers[i]->start);
+		}
+		DrawTileStrip(0);
+		for (size_t i = 0; i < renderWorkers.size(); i++) {
+			SDL_SemWait(stripsDone);
+		}
+	}
+	tileBatch.clear();
+}
+
+void SDLVideoDriver::DrawTileStrip(int strip)
+{
+	int top = batchTop + strip * stripHeight;
+	int bottom = top + stripHeight;
+	for (size_t i = 0; i < tileBatch.size(); i++) {
+		DrawTile(tileBatch[i], top, bottom);
+	}
+}
+
+int SDLVideoDriver::RenderWorkerLoop(void* arg)
+{
+	RenderWorker* worker = (RenderWorker*) arg;
+	SDLVideoDriver* driver = worker->driver;
+	while (true) {
+		SDL_SemWait(worker->start);
+		if (driver->stopWorkers) {
+			break;
+		}
+		driver->DrawTileStrip(worker->strip);
+		SDL_SemPost(driver->stripsDone);
+	}
+	return 0;
+}
+
+void SDLVideoDriver::StartRenderWorkers(int count)
+{
+	stopWorkers = false;
+	stripsDone = SDL_CreateSemaphore(0);
+	// the main thread draws the first strip itself
+	for (int i = 1; i < count; i++) {
+		RenderWorker* worker = new RenderWorker();
+		worker->driver = this;
+		worker->strip = i;
+		worker->start = SDL_CreateSemaphore(0);
+#if	SDL_VERSION_ATLEAST(1, 3, 0)
+		/* as of changeset 3a041d215edc SDL_CreateThread has a 'name' parameter */
+		worker->thread = SDL_CreateThread(&RenderWorkerLoop, "SDLVideoRender", worker);
+#else
+		worker->thread = SDL_CreateThread(&RenderWorkerLoop, worker);
+#endif
+		if (!worker->thread) {
+			Log(WARNING, "SDLVideo", "Unable to start a render thread: %s", SDL_GetError());
+			SDL_DestroySemaphore(worker->start);
+			delete worker;
+			break;
+		}
+		renderWorkers.push_back(worker);
+	}
+	Log(MESSAGE, "SDLVideo", "Drawing area tiles with %d threads", (int) renderWorkers.size() + 1);
+}
+
+void SDLVideoDriver::StopRenderWorkers()
+{
+	stopWorkers = true;
+	for (size_t i = 0; i < renderWorkers.size(); i++) {
+		RenderWorker* worker = renderWorkers[i];
+		SDL_SemPost(worker->start);
+		SDL_WaitThread(worker->thread, NULL);
+		SDL_DestroySemaphore(worker->start);
+		delete worker;
+	}
+	renderWorkers.clear();
+	if (stripsDone) {
+		SDL_DestroySemaphore(stripsDone);
+		stripsDone = NULL;
+	}
+}
+
 void SDLVideoDriver::BlitSprite(const Sprite2D* spr, int x, int y, bool anchor,
 								const Region* clip, Palette* palette)
 {
@@ -523,6 +815,7 @@ void SDLVideoDriver::BlitSprite(const Sprite2D* spr, const Region& src, const Re
 	if (dst.w <= 0 || dst.h <= 0)
 		return; // we already know blit fails
 
+	ieQword profile = core->ProfileStart();
 	if (!spr->BAM) {
 		SDL_Surface* surf = ((SDLSurfaceSprite2D*)spr)->GetSurface();
 		if (palette) {
@@ -574,6 +867,7 @@ void SDLVideoDriver::BlitSprite(const Sprite2D* spr, const Region& src, const Re
 		
 		SDL_UnlockSurface(backBuf);
 	}
+	core->ProfileEnd(PROFILE_BLITS, profile);
 }
 
 //cannot make const reference from tint, it is modified locally
@@ -658,6 +952,7 @@ void SDLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y,
 	if (finalclip.w <= 0 || finalclip.h <= 0)
 		return;
 
+	ieQword profile = core->ProfileStart();
 	SDL_LockSurface(backBuf);
 
 	bool hflip = spr->BAM ? (spr->renderFlags&BLIT_MIRRORX) : false;
@@ -671,29 +966,35 @@ void SDLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y,
 	if (remflags & BLIT_GREY) remflags &= ~BLIT_SEPIA;
 
 
+	// palette tinted up front, see TintPalette
+	Color tinted[256];
+
 	if (spr->BAM && remflags == BLIT_TINTED) {
 
 		SRShadow_Regular shadow;
-		SRTinter_Tint<false, false> tinter(tint);
+		TintPalette(tinted, palette->col, SRTinter_Tint<false, false>(tint), remflags);
+		SRTinter_NoTint<true> tinter;
 		SRBlender_NoAlpha blender;
 
-		BlitSpritePAL_dispatch(cover, hflip, backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+		BlitSpritePAL_dispatch(cover, hflip, backBuf, srcdata, tinted, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
 
 	} else if (spr->BAM && remflags == (BLIT_TINTED | BLIT_TRANSSHADOW)) {
 
 		SRShadow_HalfTrans shadow(backBuf->format, palette->col[1]);
-		SRTinter_Tint<false, false> tinter(tint);
+		TintPalette(tinted, palette->col, SRTinter_Tint<false, false>(tint), remflags);
+		SRTinter_NoTint<true> tinter;
 		SRBlender_NoAlpha blender;
 
-		BlitSpritePAL_dispatch(cover, hflip, backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+		BlitSpritePAL_dispatch(cover, hflip, backBuf, srcdata, tinted, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
 
 	} else if (spr->BAM && remflags == (BLIT_TINTED | BLIT_NOSHADOW)) {
 
 		SRShadow_None shadow;
-		SRTinter_Tint<false, false> tinter(tint);
+		TintPalette(tinted, palette->col, SRTinter_Tint<false, false>(tint), remflags);
+		SRTinter_NoTint<true> tinter;
 		SRBlender_NoAlpha blender;
 
-		BlitSpritePAL_dispatch(cover, hflip, backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+		BlitSpritePAL_dispatch(cover, hflip, backBuf, srcdata, tinted, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
 
 	} else if (spr->BAM && remflags == BLIT_HALFTRANS) {
 
@@ -734,30 +1035,22 @@ void SDLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y,
 		SRBlender_Alpha blender;
 		if (remflags & blit_PALETTEALPHA) {
 			if (remflags & BLIT_TINTED) {
-				SRTinter_Flags<true> tinter(tint);
-
-				BlitSpritePAL_dispatch(cover, hflip,
-				    backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+				TintPalette(tinted, palette->col, SRTinter_Flags<true>(tint), remflags);
 			} else {
-				SRTinter_FlagsNoTint<true> tinter;
-
-				BlitSpritePAL_dispatch(cover, hflip,
-				    backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+				TintPalette(tinted, palette->col, SRTinter_FlagsNoTint<true>(), remflags);
 			}
 		} else {
 			if (remflags & BLIT_TINTED) {
-				SRTinter_Flags<false> tinter(tint);
-
-				BlitSpritePAL_dispatch(cover, hflip,
-				    backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+				TintPalette(tinted, palette->col, SRTinter_Flags<false>(tint), remflags);
 			} else {
-				SRTinter_FlagsNoTint<false> tinter;
-
-				BlitSpritePAL_dispatch(cover, hflip,
-				    backBuf, srcdata, palette->col, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
+				TintPalette(tinted, palette->col, SRTinter_FlagsNoTint<false>(), remflags);
 			}
-
 		}
+		// the tinted palette already holds the final alpha
+		SRTinter_NoTint<true> tinter;
+
+		BlitSpritePAL_dispatch(cover, hflip,
+		    backBuf, srcdata, tinted, tx, ty, spr->Width, spr->Height, vflip, finalclip, (Uint8)spr->GetColorKey(), cover, spr, remflags, shadow, tinter, blender);
 	} else {
 		// non-BAM Blitting
 
@@ -842,7 +1135,7 @@ void SDLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y,
 	}
 
 	SDL_UnlockSurface(backBuf);
-
+	core->ProfileEnd(PROFILE_BLITS, profile);
 }
 
 Sprite2D* SDLVideoDriver::GetScreenshot( Region r )
@@ -26,6 +26,8 @@
 #include "GUI/EventMgr.h"
 #include "win32def.h"
 
+#include <list>
+#include <map>
 #include <vector>
 #include <SDL.h>
 
@@ -58,6 +60,59 @@ protected:
 
 	String *subtitletext;
 	ieDword subtitlestrref;
+
+	//tiles already converted to the backbuffer format, see BlitTile
+	struct TileKey {
+		const Sprite2D* spr;
+		Uint32 tint;
+		unsigned int flags;
+
+		bool operator<(const TileKey& other) const
+		{
+			if (spr != other.spr) return spr < other.spr;
+			if (tint != other.tint) return tint < other.tint;
+			return flags < other.flags;
+		}
+	};
+	struct CachedTile {
+		TileKey key;
+		Uint8* pixels;
+		unsigned int frame; //last frame it was drawn in
+	};
+	typedef std::list<CachedTile> TileList;
+	//most recently used first
+	TileList tileLRU;
+	std::map<TileKey, TileList::iterator> tileIndex;
+	size_t tileCacheSize, tileCacheBudget;
+	unsigned int tileFrame;
+
+	//a tile blit with everything but the drawing done, see EndTileBatch
+	struct TileCommand {
+		int x, y;
+		Region clip;
+		unsigned int flags;
+		const Uint8* data;
+		const SDL_Color* pal;
+		const Uint8* mask;
+		Uint32 ck;
+		Uint8* converted;
+		bool tint;
+		Color tintcol;
+	};
+	std::vector<TileCommand> tileBatch;
+	bool batchTiles;
+
+	//threads drawing the lower strips of a tile batch
+	struct RenderWorker {
+		SDLVideoDriver* driver;
+		SDL_Thread* thread;
+		SDL_sem* start;
+		int strip;
+	};
+	std::vector<RenderWorker*> renderWorkers;
+	SDL_sem* stripsDone;
+	bool stopWorkers;
+	int batchTop, stripHeight;
 public:
 	SDLVideoDriver(void);
 	virtual ~SDLVideoDriver(void);
@@ -92,6 +147,8 @@ public:
 
 	virtual bool SupportsBAMSprites() { return true; }
 
+	virtual void BeginTileBatch();
+	virtual void EndTileBatch();
 	virtual void BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x, int y,
 						  const Region* clip, unsigned int flags);
 	virtual void BlitSprite(const Sprite2D* spr, int x, int y, bool anchor = false,
@@ -155,6 +212,15 @@ public:
 	int PollMovieEvents();
 
 protected:
+	Uint8* GetCachedTile(const TileKey& key, bool& fresh);
+	size_t GetTileCacheBudget() const;
+	void TrimTileCache(size_t reserve);
+	void FlushTileCache();
+	void DrawTile(const TileCommand& cmd, int top, int bottom);
+	void DrawTileStrip(int strip);
+	static int RenderWorkerLoop(void* arg);
+	void StartRenderWorkers(int count);
+	void StopRenderWorkers();
 	void DrawMovieSubtitle(ieDword strRef);
 	void BlitSurfaceClipped(SDL_Surface*, const Region& src, const Region& dst);
 	virtual bool SetSurfaceAlpha(SDL_Surface* surface, unsigned short alpha)=0;
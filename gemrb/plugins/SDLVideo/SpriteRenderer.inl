@@ -292,6 +292,18 @@ struct SRBlender<Uint32, SRBlender_Alpha, SRFormat_Hard> {
 };
 
 
+// The tinters only look at the palette entry, so a paletted blit can tint
+// the 256 entries once and then copy them with SRTinter_NoTint<true>,
+// instead of tinting every single pixel.
+template<typename Tinter>
+static void TintPalette(Color* dst, const Color* src, const Tinter& tint, unsigned int flags)
+{
+	for (int i = 0; i < 256; i++) {
+		dst[i] = src[i];
+		tint(dst[i].r, dst[i].g, dst[i].b, dst[i].a, flags);
+	}
+}
+
 // MSVC6 requires all template arguments to a function to be reflected in the
 // argument list. We wrap them in the type of a dummy argument.
 template <bool b>
@@ -361,30 +373,27 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 
 
 	PTYPE *line, *end, *pix;
-	Uint8 *coverline, *coverpix;
+	// cover coordinates follow the screen: line y of the cover is screen
+	// line y - ty + covery, the same goes for columns
+	int coverrow;
+	CoverLine covered;
 	if (!yflip) {
 		line = (PTYPE*)target->pixels + ty*pitch;
 		end = (PTYPE*)target->pixels + (clip.y + clip.h)*pitch;
-		if (COVER)
-			coverline = (Uint8*)cover->pixels + covery*cover->Width;
+		coverrow = covery;
 	} else {
 		line = (PTYPE*)target->pixels + (ty + height-1)*pitch;
 		end = (PTYPE*)target->pixels + (clip.y-1)*pitch;
-		if (COVER)
-			coverline = (Uint8*)cover->pixels + (covery+height-1)*cover->Width;
+		coverrow = covery + height - 1;
 	}
 	if (!XFLIP) {
 		pix = line + tx;
 		clipstartpix = line + clip.x;
 		clipendpix = clipstartpix + clip.w;
-		if (COVER)
-			coverpix = coverline + coverx;
 	} else {
 		pix = line + tx + width - 1;
 		clipstartpix = line + clip.x + clip.w - 1;
 		clipendpix = clipstartpix - clip.w;
-		if (COVER)
-			coverpix = coverline + coverx + width - 1;
 	}
 
 	// clipstartpix is the first pixel to draw
@@ -395,6 +404,9 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 
 	while (line != end) {
 
+		if (COVER)
+			covered.Start(cover, coverrow);
+
 		// Fast-forward through the RLE data until we reach clipstartpix
 
 		if (!XFLIP) {
@@ -406,8 +418,6 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 				else
 					count = 1;
 				pix += count;
-				if (COVER)
-					coverpix += count;
 			}
 		} else {
 			while (pix > clipstartpix) {
@@ -418,8 +428,6 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 				else
 					count = 1;
 				pix -= count;
-				if (COVER)
-					coverpix -= count;
 			}
 		}
 
@@ -434,15 +442,11 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 					int count = (int)(*srcdata++) + 1;
 					if (!XFLIP) {
 						pix += count;
-						if (COVER)
-							coverpix += count;
 					} else {
 						pix -= count;
-						if (COVER)
-							coverpix -= count;
 					}
 				} else {
-					if (!COVER || !*coverpix) {
+					if (!COVER || !covered.Covered((int)(pix - line) - tx + coverx)) {
 						int extra_alpha = 0;
 						if (!shadow(*pix, p, extra_alpha, flags)) {
 							Uint8 r = col[p].r;
@@ -461,10 +465,8 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 
 					if (!XFLIP) {
 						pix++;
-						if (COVER) coverpix++;
 					} else {
 						pix--;
-						if (COVER) coverpix--;
 					}
 				}
 			}
@@ -475,8 +477,7 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 
 		line += yfactor * pitch;
 		pix += yfactor * pitch - xfactor * width;
-		if (COVER)
-			coverpix += yfactor * cover->Width - xfactor * width;
+		coverrow += yfactor;
 		clipstartpix += yfactor * pitch;
 		clipendpix += yfactor * pitch;
 	}
@@ -525,20 +526,21 @@ static void BlitSprite_internal(SDL_Surface* target,
 
 
 	PTYPE *line, *end;
-	Uint8 *coverpix;
+	// cover coordinates follow the screen: line y of the cover is screen
+	// line y - ty + covery, the same goes for columns
+	int coverrow;
+	CoverLine covered;
 
 	if (!yflip) {
 		line = (PTYPE*)target->pixels + clip.y*pitch;
 		end = line + clip.h*pitch;
 		srcdata += (clip.y - ty)*spr->Width;
-		if (COVER)
-			coverpix = (Uint8*)cover->pixels + (clip.y - ty + covery)*cover->Width;
+		coverrow = clip.y - ty + covery;
 	} else {
 		line = (PTYPE*)target->pixels + (clip.y + clip.h - 1)*pitch;
 		end = line - clip.h*pitch;
 		srcdata += (ty + spr->Height - (clip.y + clip.h))*spr->Width;
-		if (COVER)
-			coverpix = (Uint8*)cover->pixels + (clip.y - ty + clip.h + covery - 1)*cover->Width;
+		coverrow = clip.y - ty + clip.h + covery - 1;
 	}
 
 	PTYPE *pix, *endpix;
@@ -546,24 +548,35 @@ static void BlitSprite_internal(SDL_Surface* target,
 		pix = line + clip.x;
 		endpix = pix + clip.w;
 		srcdata += clip.x - tx;
-		if (COVER)
-			coverpix += clip.x - tx + coverx;
 	} else {
 		pix = line + clip.x + clip.w - 1;
 		endpix = pix - clip.w;
 		srcdata += tx + spr->Width - (clip.x + clip.w);
-		if (COVER)
-			coverpix += clip.x - tx + clip.w + coverx - 1;
 	}
 
 	const int yfactor = yflip ? -1 : 1;
 	const int xfactor = XFLIP ? -1 : 1;
 
 	while (line != end) {
+		if (COVER)
+			covered.Start(cover, coverrow);
 		do {
+#ifndef HIGHLIGHTCOVER
+			if (COVER) {
+				// skip walls in whole runs instead of pixel by pixel
+				int run = covered.CoveredRun((int)(pix - line) - tx + coverx, xfactor);
+				if (run) {
+					int left = (int)(endpix - pix) * xfactor;
+					if (run > left) run = left;
+					pix += xfactor * run;
+					srcdata += run;
+					continue;
+				}
+			}
+#endif
 			Uint8 p = *srcdata++;
 			if ((int)p != transindex) {
-				if (!COVER || !*coverpix) {
+				if (!COVER || !covered.Covered((int)(pix - line) - tx + coverx)) {
 					int extra_alpha = 0;
 					if (!shadow(*pix, p, extra_alpha, flags)) {
 						Uint8 r = col[p].r;
@@ -582,10 +595,8 @@ static void BlitSprite_internal(SDL_Surface* target,
 			}
 			if (!XFLIP) {
 				pix++;
-				if (COVER) coverpix++;
 			} else {
 				pix--;
-				if (COVER) coverpix--;
 			}
 		} while (pix != endpix);
 
@@ -594,8 +605,7 @@ static void BlitSprite_internal(SDL_Surface* target,
 		endpix += yfactor * pitch;
 		line += yfactor * pitch;
 		srcdata += (width - clip.w);
-		if (COVER)
-			coverpix += yfactor * cover->Width - xfactor * clip.w;
+		coverrow += yfactor;
 	}
 
 }
@@ -641,20 +651,21 @@ static void BlitSpriteRGB_internal(SDL_Surface* target,
 
 
 	PTYPE *line, *end;
-	Uint8 *coverpix;
+	// cover coordinates follow the screen: line y of the cover is screen
+	// line y - ty + covery, the same goes for columns
+	int coverrow;
+	CoverLine covered;
 
 	if (!yflip) {
 		line = (PTYPE*)target->pixels + clip.y*pitch;
 		end = line + clip.h*pitch;
 		srcdata += (clip.y - ty)*spr->Width;
-		if (COVER)
-			coverpix = (Uint8*)cover->pixels + (clip.y - ty + covery)*cover->Width;
+		coverrow = clip.y - ty + covery;
 	} else {
 		line = (PTYPE*)target->pixels + (clip.y + clip.h - 1)*pitch;
 		end = line - clip.h*pitch;
 		srcdata += (ty + spr->Height - (clip.y + clip.h))*spr->Width;
-		if (COVER)
-			coverpix = (Uint8*)cover->pixels + (clip.y - ty + clip.h + covery - 1)*cover->Width;
+		coverrow = clip.y - ty + clip.h + covery - 1;
 	}
 
 	PTYPE *pix, *endpix;
@@ -662,25 +673,36 @@ static void BlitSpriteRGB_internal(SDL_Surface* target,
 		pix = line + clip.x;
 		endpix = pix + clip.w;
 		srcdata += clip.x - tx;
-		if (COVER)
-			coverpix += clip.x - tx + coverx;
 	} else {
 		pix = line + clip.x + clip.w - 1;
 		endpix = pix - clip.w;
 		srcdata += tx + spr->Width - (clip.x + clip.w);
-		if (COVER)
-			coverpix += clip.x - tx + clip.w + coverx - 1;
 	}
 
 	const int yfactor = yflip ? -1 : 1;
 	const int xfactor = XFLIP ? -1 : 1;
 
 	while (line != end) {
+		if (COVER)
+			covered.Start(cover, coverrow);
 		do {
+#ifndef HIGHLIGHTCOVER
+			if (COVER) {
+				// skip walls in whole runs instead of pixel by pixel
+				int run = covered.CoveredRun((int)(pix - line) - tx + coverx, xfactor);
+				if (run) {
+					int left = (int)(endpix - pix) * xfactor;
+					if (run > left) run = left;
+					pix += xfactor * run;
+					srcdata += run;
+					continue;
+				}
+			}
+#endif
 			Uint32 p = *srcdata++;
 			Uint8 a = (Uint8)(p >> 24);
 			if (a != 0) {
-				if (!COVER || !*coverpix) {
+				if (!COVER || !covered.Covered((int)(pix - line) - tx + coverx)) {
 					Uint8 r = (Uint8)(p);
 					Uint8 g = (Uint8)(p >> 8);
 					Uint8 b = (Uint8)(p >> 16);
@@ -695,10 +717,8 @@ static void BlitSpriteRGB_internal(SDL_Surface* target,
 			}
 			if (!XFLIP) {
 				pix++;
-				if (COVER) coverpix++;
 			} else {
 				pix--;
-				if (COVER) coverpix--;
 			}
 		} while (pix != endpix);
 
@@ -707,8 +727,7 @@ static void BlitSpriteRGB_internal(SDL_Surface* target,
 		endpix += yfactor * pitch;
 		line += yfactor * pitch;
 		srcdata += (width - clip.w);
-		if (COVER)
-			coverpix += yfactor * cover->Width - xfactor * clip.w;
+		coverrow += yfactor;
 	}
 
 }
@@ -89,6 +89,9 @@ struct TRBlender_HalfTrans {
 	Uint32 mask;
 };
 
+static inline bool IsOpaque(const TRBlender_Opaque&) { return true; }
+static inline bool IsOpaque(const TRBlender_HalfTrans&) { return false; }
+
 
 //the dummy variable is a hint for MSVC6, otherwise it compiles bad code
 //because it cannot select between the 16 and 32 bit variants
@@ -152,4 +155,75 @@ static void BlitTile_internal(SDL_Surface* target,
 	}
 }
 
+// converts a whole tile to the target format, for the tile cache
+template<typename PixelType, class Tinter>
+static void ConvertTile(const SDL_PixelFormat* format, const Uint8* data,
+			const SDL_Color* pal, Tinter& tint, PixelType* out)
+{
+	PixelType opal[256];
+
+	for (unsigned int i = 0; i < 256; ++i)
+	{
+		Uint8 r = pal[i].r;
+		Uint8 g = pal[i].g;
+		Uint8 b = pal[i].b;
+		tint(r, g, b);
+		opal[i] = (r >> format->Rloss) << format->Rshift
+		                   | (g >> format->Gloss) << format->Gshift
+		                   | (b >> format->Bloss) << format->Bshift;
+	}
+
+	for (unsigned int i = 0; i < 64*64; ++i) {
+		out[i] = opal[data[i]];
+	}
+}
+
+// same as BlitTile_internal, but with the tile already converted
+template<typename PixelType, class Blender>
+static void BlitTile_converted(SDL_Surface* target,
+			int tx, int ty,
+			int rx, int ry,
+			int w, int h,
+			const PixelType* data,
+			const Uint8* mask, Uint8 mask_key,
+			Blender& blend)
+{
+	PixelType* buf_line = (PixelType*)(target->pixels) + (ty+ry)*(target->pitch / sizeof(PixelType));
+	const PixelType* data_line = data + ry*64 + rx;
+
+	if (mask) {
+		const Uint8* mask_line = mask + ry*64 + rx;
+		for (int y = 0; y < h; ++y) {
+			PixelType* buf = buf_line + tx + rx;
+			for (int x = 0; x < w; ++x) {
+				if (mask_line[x] == mask_key)
+					buf[x] = (PixelType)blend(data_line[x], buf[x]);
+			}
+			buf_line += target->pitch / sizeof(PixelType);
+			mask_line += 64;
+			data_line += 64;
+		}
+
+	} else if (IsOpaque(blend)) {
+
+		for (int y = 0; y < h; ++y) {
+			memcpy(buf_line + tx + rx, data_line, w * sizeof(PixelType));
+			buf_line += target->pitch / sizeof(PixelType);
+			data_line += 64;
+		}
+
+	} else {
+
+		for (int y = 0; y < h; ++y) {
+			PixelType* buf = buf_line + tx + rx;
+			for (int x = 0; x < w; ++x) {
+				buf[x] = (PixelType)blend(data_line[x], buf[x]);
+			}
+			buf_line += target->pitch / sizeof(PixelType);
+			data_line += 64;
+		}
+
+	}
+}
+
 }
@@ -0,0 +1,90 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+// Standalone checks for the region graph of PathCache, runs without any
+// game data: ctest or just ./PathCacheTest
+
+#include "PathCache.h"
+#include "PathFinder.h"
+
+#include <cstdio>
+
+using namespace GemRB;
+
+#define MAP_WIDTH 48
+#define MAP_HEIGHT 16
+#define WALL_X 20
+#define DOOR_Y 12
+
+static int failures = 0;
+
+static void Check(bool condition, const char *what)
+{
+	if (!condition) {
+		printf("FAILED: %s\n", what);
+		failures++;
+	}
+}
+
+//a wall splits the middle cluster in two, with a single door cell in it
+static void BuildMap(unsigned short *srchmap)
+{
+	for (unsigned int y = 0; y < MAP_HEIGHT; y++) {
+		for (unsigned int x = 0; x < MAP_WIDTH; x++) {
+			srchmap[y * MAP_WIDTH + x] = x == WALL_X ? 0 : PATH_MAP_PASSABLE;
+		}
+	}
+	srchmap[DOOR_Y * MAP_WIDTH + WALL_X] = PATH_MAP_PASSABLE | PATH_MAP_DOOR_IMPASSABLE;
+}
+
+//opening the door merges the two regions of the middle cluster, the
+//links of the neighbouring clusters must not keep the old region ids
+static void TestDoorToggle()
+{
+	unsigned short srchmap[MAP_WIDTH * MAP_HEIGHT];
+	BuildMap(srchmap);
+	PathCache cache(srchmap, MAP_WIDTH, MAP_HEIGHT);
+	Point start(2, DOOR_Y), goal(45, DOOR_Y);
+
+	Check(!cache.FindCorridor(start, goal), "closed door blocks the corridor");
+	Check(!cache.FindCorridor(goal, start), "closed door blocks the way back");
+
+	srchmap[DOOR_Y * MAP_WIDTH + WALL_X] = PATH_MAP_PASSABLE;
+	cache.Invalidate(WALL_X, DOOR_Y);
+	Check(cache.FindCorridor(goal, start), "open door connects the way back");
+	Check(cache.FindCorridor(start, goal), "open door connects the corridor");
+	Check(cache.InCorridor(WALL_X, DOOR_Y), "corridor passes the door");
+
+	srchmap[DOOR_Y * MAP_WIDTH + WALL_X] = PATH_MAP_PASSABLE | PATH_MAP_DOOR_IMPASSABLE;
+	cache.Invalidate(WALL_X, DOOR_Y);
+	Check(!cache.FindCorridor(start, goal), "closed again door blocks the corridor");
+	Check(!cache.FindCorridor(goal, start), "closed again door blocks the way back");
+}
+
+int main()
+{
+	TestDoorToggle();
+	if (failures) {
+		printf("%d PathCache check(s) failed\n", failures);
+		return 1;
+	}
+	printf("PathCache checks passed\n");
+	return 0;
+}